@@ -14,21 +14,57 @@
                // lamdas, I believe Hackerrank allows UP TO uses C++20
 #include <algorithm> // std::sort, std::transform, std::find (std::find - make sure to override operator==)
 #include <array>
+#include <atomic>     // std::atomic for counters shared across threads
+#include <bit>        // std::bit_width, std::endian
 #include <cassert>    // assert()
+#include <charconv>   // std::from_chars_result
 #include <chrono>     // for start/end time measurement
+#include <compare>    // std::strong_ordering
+#include <condition_variable>
+#include <cmath>      // std::log10, std::sqrt, std::ceil, std::pow
 #include <cstdint>    // std::uint16_t, etc - I'm too used to rust types...
+#include <cstdio>     // std::FILE for write_to()
+#include <cstring>    // std::memcpy, std::memcmp
+#include <deque>      // Thread_Pool task queues
+#include <exception>  // std::exception_ptr
+#include <filesystem> // std::filesystem::temp_directory_path
 #include <fstream>    // for reading in file
 #include <functional> // lambdas!
+#include <initializer_list>
+#include <iomanip>    // std::setw
 #include <iostream>   // std::cout
+#include <iterator>   // std::reverse_iterator, std::input_iterator
+#include <limits>
+#include <list>       // LRU order of Sequence_Cache checkpoints
+#include <map>        // std::map (ordered, for "nearest checkpoint below")
 #include <memory>     // std::shared_ptr, std::make_shared
+#include <memory_resource> // std::pmr::memory_resource for arenas/pools
+#include <mutex>
 #include <optional>   // a bit different from Rust Option<T> but still, useful!
+#include <random>     // std::mt19937 for randomized unit tests
+#include <span>       // std::span for the batch APIs
+#include <sstream>    // std::ostringstream
 #include <stack> // commonly used when I need to convert recursive to iterative
 #include <string>
+#include <string_view>
+#include <thread>
 #include <tuple>
 #include <unordered_map> // use map if need keys to be ordered, but generally, I just need key to be hashed...
 #include <unordered_set>
 #include <utility> // std::pair, etc
 #include <vector>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+// SSE2/AVX2 limb kernels, picked at runtime (see Limb_Kernels)
+#define LARGE_NUMBERS_HAS_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+#if defined(__unix__) || defined(__APPLE__)
+#define LARGE_NUMBERS_HAS_MMAP 1
+#include <fcntl.h>    // open()
+#include <sys/mman.h> // mmap()
+#include <sys/stat.h> // fstat()
+#include <unistd.h>   // close()
+#endif
 #else
 // fail compiler if C++ version is less than C++20
 // but without using static_assert() because it's not available until C++17
@@ -39,40 +75,385 @@ using namespace std;
 
 namespace hairev {
 namespace libs {
+// Work-stealing thread pool: every worker has its own task queue, pushes to
+// and pops from its back (newest first, which keeps nested fork/join tasks
+// cache friendly), and when it runs dry steals from the front (oldest,
+// usually the biggest chunk of work) of the others.  Tasks pushed from a
+// thread outside the pool are dealt round robin.  Threads waiting on tasks
+// (see Task_Group::Wait()) run pending tasks meanwhile rather than block, so
+// tasks may freely fork and wait on tasks of their own.
+class Thread_Pool {
+public:
+  explicit Thread_Pool(
+      std::size_t threads = std::max(1u, std::thread::hardware_concurrency())) {
+    // at least one worker (and queue), i.e. hardware_concurrency() - 1 on a
+    // single core machine still makes a usable pool
+    threads = std::max<std::size_t>(threads, 1);
+    for (std::size_t i = 0; i < threads; i++) {
+      queues.push_back(std::make_unique<Queue>());
+    }
+    for (std::size_t i = 0; i < threads; i++) {
+      workers.emplace_back([this, i]() { work(i); });
+    }
+  }
+  ~Thread_Pool() {
+    {
+      auto lock = std::lock_guard<std::mutex>(sleep_mutex);
+      stopping = true;
+    }
+    sleep_condition.notify_all();
+    for (auto &worker : workers) {
+      worker.join();
+    }
+  }
+  Thread_Pool(const Thread_Pool &) = delete;
+  Thread_Pool &operator=(const Thread_Pool &) = delete;
+
+  // shared pool with one thread per core, created on first use
+  static Thread_Pool &Default() {
+    static Thread_Pool pool;
+    return pool;
+  }
+  std::size_t Size() const { return workers.size(); }
+
+  void Push(std::function<void()> task) {
+    auto index = current_pool == this
+                     ? current_worker
+                     : next_queue.fetch_add(1) % queues.size();
+    {
+      auto lock = std::lock_guard<std::mutex>(queues[index]->mutex);
+      queues[index]->tasks.push_back(std::move(task));
+    }
+    {
+      auto lock = std::lock_guard<std::mutex>(sleep_mutex);
+      pending++;
+    }
+    sleep_condition.notify_one();
+  }
+  // runs one pending task on the calling thread, own queue first and then
+  // stealing; false if there was nothing to run.  The task runs without the
+  // caller's Large_Numbers::Parallel, since it is usually unrelated work
+  // stolen while waiting (defined after Large_Numbers)
+  bool Run_Pending_Task();
+
+private:
+  struct Queue {
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+  };
+
+  void work(std::size_t index) {
+    current_pool = this;
+    current_worker = index;
+    while (true) {
+      if (Run_Pending_Task()) {
+        continue;
+      }
+      auto lock = std::unique_lock<std::mutex>(sleep_mutex);
+      sleep_condition.wait(lock, [this]() { return stopping || pending > 0; });
+      if (stopping) {
+        return;
+      }
+    }
+  }
+
+  std::vector<std::unique_ptr<Queue>> queues;
+  std::vector<std::thread> workers;
+  std::atomic<std::size_t> next_queue{0};
+  std::atomic<std::size_t> pending{0}; // pushed but not yet taken
+  std::mutex sleep_mutex;
+  std::condition_variable sleep_condition;
+  bool stopping = false; // guarded by sleep_mutex
+  static inline thread_local Thread_Pool *current_pool = nullptr;
+  static inline thread_local std::size_t current_worker = 0;
+};
+
+// Fork/join on a Thread_Pool: Run() as many tasks as needed, then Wait() for
+// all of them, which runs pending tasks of the pool while waiting and
+// rethrows the first exception any of the tasks threw
+class Task_Group {
+public:
+  explicit Task_Group(Thread_Pool &pool) : pool(pool) {}
+  ~Task_Group() {
+    while (remaining > 0) {
+      if (!pool.Run_Pending_Task()) {
+        std::this_thread::yield();
+      }
+    }
+  }
+  Task_Group(const Task_Group &) = delete;
+  Task_Group &operator=(const Task_Group &) = delete;
+
+  template <typename Task> void Run(Task task) {
+    remaining++;
+    pool.Push([this, task]() {
+      try {
+        task();
+      } catch (...) {
+        auto lock = std::lock_guard<std::mutex>(error_mutex);
+        if (!error) {
+          error = std::current_exception();
+        }
+      }
+      remaining--;
+    });
+  }
+  void Wait() {
+    while (remaining > 0) {
+      if (!pool.Run_Pending_Task()) {
+        std::this_thread::yield();
+      }
+    }
+    if (error) {
+      std::rethrow_exception(std::exchange(error, nullptr));
+    }
+  }
+
+private:
+  Thread_Pool &pool;
+  std::atomic<std::size_t> remaining{0};
+  std::mutex error_mutex;
+  std::exception_ptr error;
+};
+
 class Large_Numbers {
+  // clears parallel_context around the tasks it runs
+  friend class Thread_Pool;
 
 private:
   // NOTE: I'm using vector<uint32_t> instead of string and/or vector<uint8_t>
   // because uint8_t gives really unpredictable output routed to std::cout
   // because cout << thinks it's a char, and I don't want to bother wasting
   // time doing std::cout << static_cast<int>(some_uint8_t_value) every time
+  // Each uint32_t is a "limb" which packs 9 decimal digits (base 10^9) rather
+  // than a single digit; 10^9 is the largest power of 10 that fits in 32-bits
+  // AND whose sum of two limbs (2 * 10^9 - 2) still fits in uint32_t, and
+  // whose product of two limbs (10^18) fits in uint64_t.  Because the base is
+  // a power of 10, converting to/from decimal string is just a matter of
+  // zero-padding each limb to 9 digits, and we touch ~1/9th of the memory (and
+  // loop iterations) compared to one-digit-per-uint32_t
   // A careful caution must be made, on uint because there are some functions
   // which I'm updating in-place (i.e. lhs[i] -= rhs[i]) and if lhs[i] < rhs[i],
   // lhs[i] will turn this negative into uint underflow (i.e. 0 - 1 =
-  // 4294967295); with that mentioned about updating in-place, because each
-  // digits are in range of +0..+9, it's definitely safe to use uint16_t (not
-  // uint8_t since it seems to cause issues and thinks it's char), but I'm using
-  // uint32_t because of my suspicion that if it does unexplainable things with
-  // char confusion on 8-bits, it'll probably do the same on wchar (16-bits),
-  // and in today's CPU, using native 32-bits is much more faster/optimized than
-  // downcasting to 8 or 16 bits (i.e. wasting 32-bit register to pack upper
-  // 24-bits with 0's)
-  typedef std::vector<std::uint32_t>
-      int_revvec_t; // todo: write iterator for this defined type
+  // 4294967295), so borrow/carry math is done in signed/wider types
+  typedef std::uint32_t limb_t;
+  typedef std::uint64_t double_limb_t; // wide enough for limb * limb + carry
+  static constexpr limb_t LIMB_BASE = 1000000000; // 10^9
+  static constexpr std::size_t LIMB_DIGITS = 9;   // decimal digits per limb
+
+  // Most numbers in practice are small (counters, indices, coefficients), so
+  // rather than std::vector (which always heap-allocates), limbs are kept
+  // in-place in the object for up to INLINE_CAPACITY limbs (36 digits, so any
+  // int64_t/uint64_t fits) and only spills to the heap when it grows past it.
+  // It only implements the subset of std::vector that this class needs.
+  // Spilled buffers come from a std::pmr::memory_resource: the one current
+  // for the thread when the vector was constructed (see
+  // Memory_Resource_Scope and Arena).  As with the std::pmr containers, a
+  // move-constructed vector takes over the resource of its source, while
+  // move assignment and swap keep each vector's own resource: buffers are
+  // only handed over between equal resources, otherwise the limbs are copied
+  // (so a number never ends up pointing into, say, an Arena that goes away
+  // before it does).
+  class Limb_Vector {
+  public:
+    static constexpr std::size_t INLINE_CAPACITY = 4;
+    // number of heap (spill) allocations made so far, by all instances
+    static inline std::atomic<std::uint64_t> heap_allocations{0};
+
+    typedef limb_t value_type;
+    typedef limb_t *iterator;
+    typedef const limb_t *const_iterator;
+    typedef std::reverse_iterator<limb_t *> reverse_iterator;
+    typedef std::reverse_iterator<const limb_t *> const_reverse_iterator;
+
+    Limb_Vector() noexcept : Limb_Vector(current_resource()) {}
+    explicit Limb_Vector(std::pmr::memory_resource *resource) noexcept
+        : limbs_size(0), limbs_capacity(INLINE_CAPACITY),
+          limbs_resource(resource) {}
+    explicit Limb_Vector(std::size_t size, limb_t value = 0) : Limb_Vector() {
+      resize(size, value);
+    }
+    Limb_Vector(std::initializer_list<limb_t> limbs) : Limb_Vector() {
+      assign(limbs.begin(), limbs.end());
+    }
+    template <std::input_iterator Iterator>
+    Limb_Vector(Iterator first, Iterator last) : Limb_Vector() {
+      assign(first, last);
+    }
+    Limb_Vector(const Limb_Vector &other) : Limb_Vector() {
+      assign(other.begin(), other.end());
+    }
+    Limb_Vector(Limb_Vector &&other) noexcept
+        : Limb_Vector(other.limbs_resource) {
+      steal(other);
+    }
+    Limb_Vector &operator=(const Limb_Vector &other) {
+      if (this != &other) {
+        assign(other.begin(), other.end());
+      }
+      return *this;
+    }
+    Limb_Vector &operator=(Limb_Vector &&other) {
+      if (this == &other) {
+        return *this;
+      }
+      if (*limbs_resource != *other.limbs_resource) {
+        assign(other.begin(), other.end());
+        return *this;
+      }
+      release();
+      steal(other);
+      return *this;
+    }
+    ~Limb_Vector() { release(); }
+
+    std::size_t size() const { return limbs_size; }
+    bool empty() const { return limbs_size == 0; }
+    std::size_t capacity() const { return limbs_capacity; }
+    bool is_inline() const { return limbs_capacity == INLINE_CAPACITY; }
+    std::pmr::memory_resource *resource() const { return limbs_resource; }
+    limb_t *data() { return is_inline() ? inline_limbs : heap_limbs; }
+    const limb_t *data() const {
+      return is_inline() ? inline_limbs : heap_limbs;
+    }
+    limb_t &operator[](std::size_t i) { return data()[i]; }
+    const limb_t &operator[](std::size_t i) const { return data()[i]; }
+    limb_t &back() { return data()[limbs_size - 1]; }
+    const limb_t &back() const { return data()[limbs_size - 1]; }
+    iterator begin() { return data(); }
+    iterator end() { return data() + limbs_size; }
+    const_iterator begin() const { return data(); }
+    const_iterator end() const { return data() + limbs_size; }
+    reverse_iterator rbegin() { return reverse_iterator(end()); }
+    reverse_iterator rend() { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin() const {
+      return const_reverse_iterator(end());
+    }
+    const_reverse_iterator rend() const {
+      return const_reverse_iterator(begin());
+    }
+
+    void reserve(std::size_t capacity) {
+      if (capacity <= limbs_capacity) {
+        return;
+      }
+      auto grown = static_cast<limb_t *>(
+          limbs_resource->allocate(capacity * sizeof(limb_t), alignof(limb_t)));
+      heap_allocations++;
+      std::copy(begin(), end(), grown);
+      release();
+      heap_limbs = grown;
+      limbs_capacity = capacity;
+    }
+    void resize(std::size_t size, limb_t value = 0) {
+      if (size > limbs_capacity) {
+        reserve(std::max(size, limbs_capacity * 2));
+      }
+      if (size > limbs_size) {
+        std::fill(data() + limbs_size, data() + size, value);
+      }
+      limbs_size = size;
+    }
+    void clear() { limbs_size = 0; }
+    void push_back(limb_t limb) {
+      if (limbs_size == limbs_capacity) {
+        reserve(limbs_capacity * 2);
+      }
+      data()[limbs_size++] = limb;
+    }
+    void pop_back() { limbs_size--; }
+    template <std::input_iterator Iterator>
+    void assign(Iterator first, Iterator last) {
+      auto size = (std::size_t)std::distance(first, last);
+      if (size > limbs_capacity) {
+        clear();
+        reserve(size);
+      }
+      std::copy(first, last, data());
+      limbs_size = size;
+    }
+    void swap(Limb_Vector &other) {
+      if (*limbs_resource != *other.limbs_resource) {
+        auto temporary = Limb_Vector(limbs_resource);
+        temporary.assign(begin(), end());
+        assign(other.begin(), other.end());
+        other.assign(temporary.begin(), temporary.end());
+        return;
+      }
+      auto temporary = std::move(other);
+      other = std::move(*this);
+      *this = std::move(temporary);
+    }
+    friend void swap(Limb_Vector &lhs, Limb_Vector &rhs) {
+      lhs.swap(rhs);
+    }
+    bool operator==(const Limb_Vector &other) const {
+      return limbs_size == other.limbs_size &&
+             std::equal(begin(), end(), other.begin());
+    }
+    bool operator!=(const Limb_Vector &other) const {
+      return !(*this == other);
+    }
+
+    // resource used by vectors constructed on this thread from now on;
+    // nullptr means std::pmr::get_default_resource()
+    static inline thread_local std::pmr::memory_resource *thread_resource =
+        nullptr;
+    static std::pmr::memory_resource *current_resource() {
+      return thread_resource != nullptr ? thread_resource
+                                        : std::pmr::get_default_resource();
+    }
+
+  private:
+    // heap buffer is released and we go back to inline storage
+    void release() {
+      if (!is_inline()) {
+        limbs_resource->deallocate(heap_limbs, limbs_capacity * sizeof(limb_t),
+                                   alignof(limb_t));
+      }
+      limbs_capacity = INLINE_CAPACITY;
+    }
+    // takes over other's heap buffer (or copies its inline limbs), leaving
+    // other empty; assumes this has no heap buffer and an equal resource
+    void steal(Limb_Vector &other) {
+      if (other.is_inline()) {
+        std::copy(other.inline_limbs, other.inline_limbs + other.limbs_size,
+                  inline_limbs);
+      } else {
+        heap_limbs = other.heap_limbs;
+        limbs_capacity = other.limbs_capacity;
+        other.limbs_capacity = INLINE_CAPACITY;
+      }
+      limbs_size = other.limbs_size;
+      other.limbs_size = 0;
+    }
+
+    union {
+      limb_t inline_limbs[INLINE_CAPACITY];
+      limb_t *heap_limbs;
+    };
+    std::size_t limbs_size;
+    std::size_t limbs_capacity;
+    std::pmr::memory_resource *limbs_resource;
+  };
+  typedef Limb_Vector int_revvec_t; // todo: write iterator for this defined type
   typedef bool sign_t;
-  // NOTE: Internal representation is in reverse order (i.e. 1234 is stored as
-  // {4, 3, 2, 1}) because it's easier to add and subtract that way
-  // and only when rendering (i.e. dump, to_string) will it be reversed
+  // NOTE: Internal representation is in reverse order (i.e. 1234567890123 is
+  // stored as {567890123, 1234}) because it's easier to add and subtract that
+  // way and only when rendering (i.e. dump, to_string) will it be reversed
   // hence these are private and should not be accessed directly
+  // Zero is always stored as {0} (never as an empty vector)
   int_revvec_t value;
   sign_t is_positive;
 
-  const int_revvec_t vec_zero = int_revvec_t{0}; // it has no sign
-  const int_revvec_t vec_one = int_revvec_t{1};  // it has no sign
+  // shared by all instances (as static) rather than each object carrying its
+  // own heap-allocated copies around
+  static inline const int_revvec_t vec_zero = int_revvec_t{0}; // has no sign
+  static inline const int_revvec_t vec_one = int_revvec_t{1};  // has no sign
 
 public:
   Large_Numbers(const uint64_t &v) : is_positive(true) {
-    auto tup = i64_to_digits(v);
+    auto tup = u64_to_digits(v);
     value = std::get<1>(tup);
     is_positive = std::get<0>(tup);
   }
@@ -81,25 +462,19 @@ public:
     value = std::get<1>(tup);
     is_positive = std::get<0>(tup);
   }
-  Large_Numbers(const std::string &str_v, bool is_positive)
+  // NOTE: the sign is whatever str_v says (i.e. "-5" is negative even with
+  // is_positive=true), from_string() throws std::invalid_argument on bad input
+  Large_Numbers(std::string_view str_v, bool is_positive)
       : is_positive(is_positive) {
-
     auto fs = from_string(str_v);
-    this->value = fs.value;
+    this->value = std::move(fs.value);
     this->is_positive = fs.is_positive;
-    if (this->is_positive != fs.is_positive) {
-      std::clog << "Sign mismatch: '" << str_v
-                << "' was passed as is_positive=" << this->is_positive
-                << " but converter from_strin() thinks it is " << fs.is_positive
-                << std::endl;
-      throw std::invalid_argument("Sign mismatch");
-    }
   }
-  Large_Numbers(const std::string &v) : Large_Numbers(v, true) {}
+  Large_Numbers(std::string_view v) : Large_Numbers(v, true) {}
   ~Large_Numbers() {}
   static Large_Numbers New() { return Zero(); }
   static Large_Numbers Zero() { return Large_Numbers(int_revvec_t{0}, true); }
-  bool Is_Positive() {
+  bool Is_Positive() const {
     // if it's zero, it's positive even if is_positive is false
     return this->is_positive || this->Is_Zero();
   }
@@ -110,731 +485,3209 @@ public:
     // see it aligned Note that padding_char are ignored if width is 0
     return to_string_with_padding(width, padding_char);
   }
-  size_t Size() const { return this->value.size(); }
-  void Dump() const { dump_digits(*this); }
-
-  // NOTE: both +0 and -0 should return true
-  bool Is_Zero() const { return op_equal(this->value, vec_zero); }
-
-  static Large_Numbers Fibonacci(const std::uint64_t &n) {
-    // for performance, we'll just call the iterative version
-    auto my_large_number = Large_Numbers(n);
-    auto result = my_large_number.fibonacci_large_iter(n);
-    return {result, true};
-  };
-
-private:
-  // we do not allow NaN
-  Large_Numbers() : is_positive(true) { value = vec_zero; }
-  Large_Numbers(int_revvec_t v, bool is_positive)
-      : value(v), is_positive(is_positive) {}
-  Large_Numbers(int_revvec_t v) : is_positive(true), value(v) {}
+  // number of decimal digits (NOT number of limbs), i.e. 1234567890 -> 10
+  size_t Size() const {
+    auto top = this->value.back();
+    size_t top_digits = 1;
+    while (top >= 10) {
+      top /= 10;
+      top_digits++;
+    }
+    return (this->value.size() - 1) * LIMB_DIGITS + top_digits;
+  }
+  void Dump(std::ostream &os = std::clog) const { dump_digits(*this, os); }
 
-public:
-  // operator overloads are public facades to the private functions as well as
-  // it's capabilites of what each function operations were designed to do
-  Large_Numbers &operator=(const Large_Numbers &rhs) {
-    this->is_positive = rhs.is_positive;
-    this->value = rhs.value;
-    return *this;
+  // writes the number as Get() would, but in chunks straight from the limbs
+  // rather than building the whole string first
+  std::ostream &write_to(std::ostream &os) const {
+    if (!this->Is_Positive()) {
+      os.put('-');
+    }
+    dump_digits(this->value, os);
+    return os;
   }
-  const Large_Numbers operator-(const Large_Numbers &rhs) const {
-    auto tup_lhs = std::make_tuple(this->is_positive, this->value);
-    auto tup_rhs = std::make_tuple(rhs.is_positive, rhs.value);
-    auto result = op_subtract_tuple(tup_lhs, tup_rhs);
-    return Large_Numbers(std::get<1>(result), std::get<0>(result));
-  }
-  Large_Numbers operator-=(Large_Numbers &rhs) { return *this - rhs; }
-  const Large_Numbers operator+(const Large_Numbers &rhs) const {
-    auto tup_lhs = std::make_tuple(this->is_positive, this->value);
-    auto tup_rhs = std::make_tuple(rhs.is_positive, rhs.value);
-    auto result = op_add_tuple(tup_lhs, tup_rhs);
-    return Large_Numbers(std::get<1>(result), std::get<0>(result));
-  }
-  Large_Numbers operator+=(Large_Numbers &rhs) { return *this + rhs; }
-  const Large_Numbers operator*(const Large_Numbers &rhs) {
-    auto tup_lhs = std::make_tuple(this->is_positive, this->value);
-    auto tup_rhs = std::make_tuple(rhs.is_positive, rhs.value);
-    auto result = op_multiply_tuple(tup_lhs, tup_rhs);
-    return Large_Numbers(std::get<1>(result), std::get<0>(result));
-  }
-  Large_Numbers operator*=(Large_Numbers &rhs) { return *this * rhs; }
-  const Large_Numbers operator/(const Large_Numbers &rhs) {
-    auto tup_lhs = std::make_tuple(this->is_positive, this->value);
-    auto tup_rhs = std::make_tuple(rhs.is_positive, rhs.value);
-    auto result = op_divide_tuple(tup_lhs, tup_rhs);
-    return Large_Numbers(std::get<1>(result), std::get<0>(result));
-  }
-  Large_Numbers operator/=(Large_Numbers &rhs) { return *this / rhs; }
-  // only reason why we have modulo is because we have division and it's too
-  // useful if paired with division
-  Large_Numbers operator%(Large_Numbers &rhs) {
-    auto tup_lhs = std::make_tuple(this->is_positive, this->value);
-    auto tup_rhs = std::make_tuple(rhs.is_positive, rhs.value);
-    auto result = op_modulo_tuple(tup_lhs, tup_rhs);
-    return Large_Numbers(std::get<1>(result), std::get<0>(result));
+  // false if the stream reported an error
+  bool write_to(std::FILE *file) const {
+    auto ok = this->Is_Positive() || std::fputc('-', file) != EOF;
+    write_limbs(this->value, [&ok, file](const char *chunk, std::size_t size) {
+      ok = ok && std::fwrite(chunk, 1, size, file) == size;
+    });
+    return ok;
   }
-  Large_Numbers operator%=(Large_Numbers &rhs) { return *this % rhs; }
-
-  // unary operators
-  Large_Numbers operator-() {
-    this->is_positive = !this->is_positive;
-    return *this;
+  // honors std::setw() (right aligned with the stream's fill char), i.e.
+  // std::cout << std::setw(10) << Large_Numbers("-42") -> "       -42"
+  friend std::ostream &operator<<(std::ostream &os, const Large_Numbers &ln) {
+    auto length = ln.to_chars_length();
+    auto width = static_cast<std::size_t>(std::max<std::streamsize>(os.width(), 0));
+    os.width(0);
+    for (; width > length; width--) {
+      os.put(os.fill());
+    }
+    return ln.write_to(os);
   }
 
-  // comparison operators
-  bool operator==(const Large_Numbers &rhs) const {
-    return (this->is_positive == rhs.is_positive) &&
-           op_equal(this->value, rhs.value);
+  // NOTE: both +0 and -0 should return true
+  bool Is_Zero() const {
+    return this->value.size() == 1 && this->value[0] == 0;
   }
-  bool operator!=(const Large_Numbers &rhs) const { return !(*this == rhs); }
-  bool operator<(const Large_Numbers &rhs) const {
-    if (this->is_positive && !rhs.is_positive) {
-      return false;
+
+  // fast doubling, O(log n) multiplications (O(M(n)) overall since the
+  // operands double in width every step) instead of the n full-width
+  // additions of fibonacci_large_iter():
+  //    F(2k)   = F(k) * (2 * F(k+1) - F(k))
+  //    F(2k+1) = F(k)^2 + F(k+1)^2
+  // the last doubling only computes the one of the two that is needed
+  static Large_Numbers Fibonacci(const std::uint64_t &n) {
+    auto [f_k, f_k_plus_1] = fibonacci_pair(n >> 1);
+    if ((n & 1) == 0) {
+      f_k_plus_1 += f_k_plus_1;
+      f_k_plus_1 -= f_k;
+      return f_k * f_k_plus_1;
     }
-    if (!this->is_positive && rhs.is_positive) {
-      return true;
+    auto f_k_squared = Zero();
+    auto f_k_plus_1_squared = Zero();
+    op_invoke(
+        f_k.value.size(), [&]() { f_k_squared = f_k * f_k; },
+        [&]() { f_k_plus_1_squared = f_k_plus_1 * f_k_plus_1; });
+    f_k_squared += f_k_plus_1_squared;
+    return f_k_squared;
+  };
+  // {F(n), F(n+1)} by fast doubling, walking the bits of n from the top
+  static std::tuple<Large_Numbers, Large_Numbers>
+  fibonacci_pair(const std::uint64_t &n) {
+    auto f_k = Large_Numbers(int_revvec_t{0}, true);
+    auto f_k_plus_1 = Large_Numbers(int_revvec_t{1}, true);
+    for (auto bit = std::bit_width(n); bit-- > 0;) {
+      auto twice_f_k_plus_1_minus_f_k = f_k_plus_1 + f_k_plus_1;
+      twice_f_k_plus_1_minus_f_k -= f_k;
+      auto f_2k = Zero();
+      auto f_2k_plus_1 = Zero();
+      auto f_k_plus_1_squared = Zero();
+      op_invoke(
+          f_k.value.size(),
+          [&]() { f_2k = f_k * twice_f_k_plus_1_minus_f_k; },
+          [&]() { f_2k_plus_1 = f_k * f_k; },
+          [&]() { f_k_plus_1_squared = f_k_plus_1 * f_k_plus_1; });
+      f_2k_plus_1 += f_k_plus_1_squared;
+      if ((n >> bit) & 1) {
+        f_2k += f_2k_plus_1; // F(2k+2) = F(2k) + F(2k+1)
+        f_k = std::move(f_2k_plus_1);
+        f_k_plus_1 = std::move(f_2k);
+      } else {
+        f_k = std::move(f_2k);
+        f_k_plus_1 = std::move(f_2k_plus_1);
+      }
     }
-    return op_less_than(this->value, rhs.value);
-  }
-  bool operator>(const Large_Numbers &rhs) const {
-    return !(*this < rhs) && !(*this == rhs);
-  }
-  bool operator<=(const Large_Numbers &rhs) const {
-    return (*this < rhs) || (*this == rhs);
-  }
-  bool operator>=(const Large_Numbers &rhs) const {
-    return (*this > rhs) || (*this == rhs);
+    return {std::move(f_k), std::move(f_k_plus_1)};
   }
 
-  // conversion operators: to const string
-  operator std::string() const { return to_string_with_padding(); }
-  std::string to_string() const { return to_string_with_padding(); }
-  std::string to_string_with_padding(int width = 0,
-                                     char padding_char = '0') const {
-    // NOTE: we do not waste time trimming in case it was padded with zeros
-    // intentionally especially when converting to string, ideally we'd like to
-    // see it aligned Note that padding_char are ignored if width is 0
+  // stateful generator of successive Fibonacci numbers, see below
+  class Fibonacci_Sequence;
 
-    // we first do the usual/regular conversion to string
-    std::string str = "";
-    if (!this->is_positive) {
-      str += "-";
+  // {index, F(index)} of the first Fibonacci number (index >= 1) that has at
+  // least digits decimal digits.  Rather than scanning, the index is
+  // predicted from Binet's formula F(k) ~ phi^k / sqrt(5), which has
+  // floor(k * log10(phi) - log10(sqrt(5))) + 1 digits, so the answer is
+  //    k = ceil((digits - 1 + log10(sqrt(5))) / log10(phi))
+  // F(k-1) and F(k) then come from one fast doubling, and the digit counts
+  // are checked in case rounding put the estimate off by one (a double has
+  // plenty of precision for that up to billions of digits)
+  static std::tuple<std::uint64_t, Large_Numbers>
+  first_fibonacci_with_digits(const std::uint64_t &digits) {
+    if (digits == 0) {
+      throw std::invalid_argument("digits must be > 0");
     }
-    for (auto digit : this->value) {
-      str += std::to_string(digit);
+    if (digits == 1) {
+      return {1, Large_Numbers(std::uint64_t(1))};
     }
-
-    // if no padding, just append the digits
-    if ((width >= 2) || (this->value.size() < width - 1)) {
-      // if here, we need to do the padding; first we want to remove the sign
-      // (if any) and then pad the rest, then put the sign back
-      if (!this->is_positive) {
-        str = str.substr(1);
-      }
-      // now pad the rest
-      while (str.size() < width) {
-        str = padding_char + str;
-      }
-      // finally, put the sign back
-      if (!this->is_positive) {
-        str = "-" + str;
-      }
+    const auto log10_phi = std::log10((1.0 + std::sqrt(5.0)) / 2.0);
+    const auto log10_sqrt_5 = std::log10(5.0) / 2.0;
+    auto index = static_cast<std::uint64_t>(
+        std::ceil((digits - 1 + log10_sqrt_5) / log10_phi));
+    auto [f_previous, f_index] = fibonacci_pair(index - 1);
+    while (f_index.Size() < digits) {
+      f_previous += f_index; // F(k+1) = F(k-1) + F(k)
+      std::swap(f_previous, f_index);
+      index++;
     }
-
-    return str;
-  }
-
-  Large_Numbers from_string(const std::string &str) {
-    if (str.size() == 0) {
-      throw std::invalid_argument("Empty string");
+    while (f_previous.Size() >= digits) {
+      f_index -= f_previous; // F(k-2) = F(k) - F(k-1)
+      std::swap(f_previous, f_index);
+      index--;
     }
+    return {index, std::move(f_index)};
+  }
 
-    auto str_v_copied = str;
-    auto ret_large_number = Large_Numbers();
-
-    // NOTE: String indexing is that 0'th index is highest digit (or sign)
-    // so we'll first check the highest digit if it's a sign, and if it
-    // is, yank it out so we can deal with the rest as digits
-    // if it's negative, override the is_positive bool and honor the sign
-    if (str_v_copied[0] == '-') {
-      ret_large_number.is_positive = false;
-      str_v_copied = str_v_copied.substr(1);
-    }
-
-    // because number here will be in order of 9876543210, we'll have to reverse
-    // it (actually, we'll just reverse the index, so we don't waste time doing
-    // in std::reverse) and then push_back to the vector, so that it's in order
-    // of 0123456789 will be pushed back in order of 0, 1, 2, 3, 4, 5, 6, 7, 8,
-    // 9 which should generate a vector of {9, 8, 7, 6, 5, 4, 3, 2, 1, 0} we'll
-    // just convert the string to vector<uint32_t>
-    // now trim spaces and commas, and truncate any values trailing "." (i.e.
-    // 1234.567 -> 1234 truncated/rounded-down rather than rounded up)
-    // locate decimal point (if any)
-    std::string::size_type pos = str_v_copied.find(".");
-    if (pos != std::string::npos) {
-      // just truncate FROM the first encounter of "."
-      str_v_copied = str_v_copied.substr(0, pos);
-    }
-    // trim commas, underscores, and spaces (in rust, I think we need to trim
-    // off "'" as well, so we'll do that here)
-    str_v_copied.erase(
-        std::remove(str_v_copied.begin(), str_v_copied.end(), ','),
-        str_v_copied.end());
-    str_v_copied.erase(
-        std::remove(str_v_copied.begin(), str_v_copied.end(), '_'),
-        str_v_copied.end());
-    str_v_copied.erase(
-        std::remove(str_v_copied.begin(), str_v_copied.end(), '\''),
-        str_v_copied.end());
-    str_v_copied.erase(
-        std::remove(str_v_copied.begin(), str_v_copied.end(), ' '),
-        str_v_copied.end());
-
-    // pop off heading zeros (i.e. 000123 -> 321) before we reverse it
-    while (str_v_copied[0] == '0') {
-      str_v_copied = str_v_copied.substr(1);
-    }
-
-    // revert the string (in-place reverse) so that it's in order we deal with
-    // internally
-    std::reverse(str_v_copied.begin(), str_v_copied.end());
-
-    // finally, convert the string to vector<uint32_t> (any non-numeric will
-    // throw) - note: if you do not locate isdigit() in ctype.h, then...
-    ret_large_number.value.clear(); // just in case it's not empty
-    for (auto c : str_v_copied) {
-      if (!isdigit(c)) {
-        std::clog << "Invalid character " << c << " in string '" << str_v_copied
-                  << "'." << std::endl;
-        throw std::invalid_argument("Invalid character in string");
-      }
-      ret_large_number.value.push_back(c - '0');
-    }
+  // crossover thresholds (in number of limbs of the SHORTER operand) used by
+  // op_multiply() to pick the algorithm; these are static so that they can be
+  // tuned per machine (i.e. Large_Numbers::Multiply_Thresholds::karatsuba =
+  // 48;) without touching the code
+  // NOTE: NTT beats Toom-3 from ~1000 limbs on my box, past that Toom-3 only
+  // kicks in for products too wide for a single NTT (see NTT_MAX_SIZE)
+  // schoolbook O(n^2) < karatsuba O(n^1.585) < toom3 O(n^1.465) < ntt
+  // O(n log n)
+  struct Multiply_Thresholds {
+    static inline std::size_t karatsuba = 32;
+    static inline std::size_t toom3 = 300;
+    static inline std::size_t ntt = 1000;
+  };
+  // divisor width (in limbs) from which op_divide() switches from Knuth's
+  // Algorithm D (O(n * m)) to Newton-iteration reciprocal (O(M(n)) per block
+  // of n quotient limbs, M(n) being the cost of a n * n op_multiply())
+  struct Divide_Thresholds {
+    static inline std::size_t newton = 2000;
+  };
+  // modulus width (in limbs) from which modpow() uses Barrett reduction even
+  // for moduli that Montgomery could handle: Montgomery's REDC is O(n^2)
+  // limb products while Barrett's 2 products go through op_multiply()
+  struct Modular_Thresholds {
+    static inline std::size_t barrett = 64;
+  };
+  // operand width (in limbs) from which xgcd()/modinv() reduce with half-GCD
+  // (O(M(n) log n)) instead of Lehmer steps (O(n^2)); gcd() alone does not
+  // need the cofactors, which makes Lehmer cheaper and moves its crossover
+  struct Gcd_Thresholds {
+    static inline std::size_t hgcd = 200;
+    static inline std::size_t hgcd_no_cofactors = 4000;
+  };
 
-    return ret_large_number;
+  // Opt-in parallel execution for multiply() and Fibonacci(): independent
+  // sub-products (the 3 of Karatsuba, the 5 of Toom-3, the 3 NTT primes, the
+  // 3 products of a fast doubling step) run as tasks on pool whenever they
+  // are at least grain limbs wide; anything narrower, as well as everything
+  // outside of these calls, runs exactly as it does without it
+  struct Parallel {
+    Thread_Pool *pool = nullptr; // nullptr: Thread_Pool::Default()
+    std::size_t grain = 2000;
+  };
+  Large_Numbers multiply(const Large_Numbers &rhs,
+                         const Parallel &parallel) const {
+    auto scope = Parallel_Scope(parallel);
+    return *this * rhs;
+  }
+  static Large_Numbers Fibonacci(const std::uint64_t &n,
+                                 const Parallel &parallel) {
+    auto scope = Parallel_Scope(parallel);
+    return Fibonacci(n);
   }
 
-  // all functions which does not deal with "this" object are private
-  // but at the same time, they should be well modularized so that one can
-  // just copy-and-paste each needed functions to other C++ projects (mainly
-  // online puzzles and competitions)
-private:
-  // note: Only dumps digits, no sign
-  static void dump_digits(const int_revvec_t &digits) {
-    // internal representation order of a number "123" is stored as {3, 2, 1}
-    // hence, iteration should be in reverse order
-    auto digits_cloned = digits;
-    std::reverse(digits_cloned.begin(), digits_cloned.end());
-    for (auto digit : digits_cloned) {
-      std::clog << digit;
+  // Batch evaluation of many independent operations: the batch is cut into
+  // contiguous chunks, a few per worker of the pool so that uneven operand
+  // widths still balance out, and each operation runs sequentially within
+  // its chunk.  Batches narrower (in total limbs) than parallel.grain, or
+  // with a single worker to run them, stay on the calling thread
+  //
+  // results[i] = operands[i].first + operands[i].second, reusing the buffers
+  // results already have
+  static void
+  add_batch(std::span<const std::pair<Large_Numbers, Large_Numbers>> operands,
+            std::span<Large_Numbers> results, const Parallel &parallel) {
+    if (operands.size() != results.size()) {
+      throw std::invalid_argument(
+          "add_batch() needs as many results as operand pairs");
+    }
+    auto width = std::size_t(0);
+    for (const auto &[lhs, rhs] : operands) {
+      width += std::max(lhs.value.size(), rhs.value.size());
     }
+    op_for_chunks(operands.size(),
+                  op_chunk_count(operands.size(), width, parallel), parallel,
+                  [&](std::size_t, std::size_t begin, std::size_t end) {
+                    for (auto i = begin; i < end; i++) {
+                      results[i] = operands[i].first;
+                      results[i] += operands[i].second;
+                    }
+                  });
   }
-  // dumps digits with sign
-  static void dump_digits(const std::tuple<bool, int_revvec_t> &tup_digits) {
-    std::clog << (get<0>(tup_digits) ? " " : "-");
-    dump_digits(get<1>(tup_digits));
+  static void
+  add_batch(std::span<const std::pair<Large_Numbers, Large_Numbers>> operands,
+            std::span<Large_Numbers> results) {
+    add_batch(operands, results, Parallel());
   }
-  static void dump_digits(const Large_Numbers &ln) {
-    std::clog << (ln.is_positive ? " " : "-");
-    dump_digits(ln.value);
+  // {F(indices[0]), F(indices[1]), ...}, indices in any order; see the
+  // definition after Fibonacci_Type_Policy
+  static std::vector<Large_Numbers>
+  fibonacci_batch(std::span<const std::uint64_t> indices,
+                  const Parallel &parallel);
+  static std::vector<Large_Numbers>
+  fibonacci_batch(std::span<const std::uint64_t> indices) {
+    return fibonacci_batch(indices, Parallel());
   }
-
-  std::tuple<bool, int_revvec_t> i64_to_digits(const std::int64_t &num64) {
-    auto digits = int_revvec_t();
-    // push_back appends to the end of the vector, hence if the sequence of the
-    // i64 is "1234" in which we'd mod% it by 10, we'd get 4, then we would
-    // push_back 4, then we'd divide by 10, and get 123, and so on and push_back
-    // to the vector the final order on the vector will be {4, 3, 2, 1} which
-    // conviniently is the reverse order we'd expect!
-    auto is_positive = num64 >= 0;
-    auto current_digit = is_positive ? num64 : -num64;
-    while (current_digit > 0) {
-      digits.push_back(current_digit % 10);
-      current_digit /= 10;
-    }
-
-    return std::tuple(is_positive, digits);
+  // sum of all terms with the carries deferred to the very end: every chunk
+  // folds its terms into its own Accumulator, the chunks' accumulators are
+  // merged pairwise in a tree, and the carries are only propagated by the
+  // final Result()
+  static Large_Numbers sum(std::span<const Large_Numbers> terms) {
+    return sum(terms, Parallel());
   }
-
-  // if the digits is "0000123" (maybe for alignment purposes), we'll trim the
-  // front zeros so that it's "123".  Because internally, digits are stored
-  // in reverse order ("000123" is stored as {3, 2, 1, 0, 0, 0}), we'll just
-  // pop off the back zeroes
-  int_revvec_t trim(const int_revvec_t &digits) {
-    // while the first digit is 0, pop it off (i.e. 000123 -> 123)
-    auto digits_cloned = digits;
-    while (digits_cloned.back() == 0) {
-      digits_cloned.pop_back();
+  static Large_Numbers sum(std::span<const Large_Numbers> terms,
+                           const Parallel &parallel) {
+    auto width = std::size_t(0);
+    for (const auto &term : terms) {
+      width += term.value.size();
     }
-    // now reverse it back to original order
-    return digits_cloned;
+    auto chunks = op_chunk_count(terms.size(), width, parallel);
+    auto accumulators =
+        std::vector<Accumulator>(std::max<std::size_t>(chunks, 1));
+    op_for_chunks(terms.size(), chunks, parallel,
+                  [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+                    for (auto i = begin; i < end; i++) {
+                      accumulators[chunk] += terms[i];
+                    }
+                  });
+    // tree reduction: at each level chunk c absorbs chunk c + stride
+    for (std::size_t stride = 1; stride < chunks; stride *= 2) {
+      auto pairs = (chunks + stride - 1) / (2 * stride);
+      op_for_chunks(pairs, pairs, parallel,
+                    [&](std::size_t, std::size_t begin, std::size_t end) {
+                      for (auto pair = begin; pair < end; pair++) {
+                        accumulators[pair * 2 * stride] +=
+                            accumulators[pair * 2 * stride + stride];
+                      }
+                    });
+    }
+    return accumulators[0].Result();
   }
-  void trim() { value = trim(value); }
 
-  // check if the number is a multiple of 10 (i.e. 10, 100, ... 10^n)
-  // Returns a tuple of (multiplier, number of 0's)
-  // i.e. 1000 -> Some(10, 3)
-  //      250 -> Some(25, 1)
-  //      1234 -> None
-  //      2500000 -> Some(25, 4)
-  // there was an interesting way to count number of digits in a number
-  // (i.e. 1234 has 4 digits) by using 'log10(n) + 1', but because we're
-  // dealing with reversed digits, we'll just count the number of 0's
-  // at the end of the number
-  std::optional<
-      std::tuple<int_revvec_t /*multiplier*/, uint64_t /*number of 0's*/>>
-  is_multiple_of_10(const int_revvec_t &number_seq) const {
-    auto multiplier = number_seq;
-    auto num_zeros = 0;
-    // just happens that num_zeros count is also the position of where to
-    // extract multipliers
-    for (auto digit : number_seq) {
-      if (digit == 0) {
-        num_zeros++;
-      } else {
-        break;
+  // Carry-save accumulator for long summations: terms are added limb by limb
+  // into 64-bit columns (positive and negative terms apart, so the columns
+  // never go below 0) without propagating any carry.  A column has room for
+  // ~1.8 * 10^10 plain terms; the carries are only propagated (normalized
+  // back to < 10^9 per column) when the next term could overflow a column,
+  // and by Result().  i.e.
+  //
+  //    auto digit_sums = Large_Numbers::Accumulator();
+  //    for (...) {
+  //      digit_sums += term;              // a Large_Numbers or an int64
+  //      digit_sums.Add(term, -3);        // += term * -3, no product built
+  //    }
+  //    auto total = digit_sums.Result();
+  class Accumulator {
+  public:
+    Accumulator &operator+=(const Large_Numbers &term) {
+      add_limbs(term.value.data(), term.value.size(), 1, 0, !term.is_positive);
+      return *this;
+    }
+    Accumulator &operator-=(const Large_Numbers &term) {
+      add_limbs(term.value.data(), term.value.size(), 1, 0, term.is_positive);
+      return *this;
+    }
+    Accumulator &operator+=(const std::int64_t &term) {
+      return add_small(term, false);
+    }
+    Accumulator &operator-=(const std::int64_t &term) {
+      return add_small(term, true);
+    }
+    // += term * scale; a scale of up to 2^32 is folded in with a single
+    // multiply per limb, wider ones as 2 or 3 shifted base 10^9 digits
+    Accumulator &Add(const Large_Numbers &term, const std::int64_t &scale) {
+      auto negative = !term.is_positive != (scale < 0);
+      auto magnitude = magnitude_of(scale);
+      if (magnitude <= std::numeric_limits<std::uint32_t>::max()) {
+        add_limbs(term.value.data(), term.value.size(), magnitude, 0,
+                  negative);
+        return *this;
+      }
+      for (std::size_t shift = 0; magnitude > 0; shift++) {
+        add_limbs(term.value.data(), term.value.size(), magnitude % LIMB_BASE,
+                  shift, negative);
+        magnitude /= LIMB_BASE;
       }
+      return *this;
     }
-    if (num_zeros == 0) {
-      return std::nullopt;
+    // merges in the columns of other (i.e. partial sums from other threads)
+    Accumulator &operator+=(const Accumulator &other) {
+      if (bound > max_column - other.bound) {
+        normalize();
+        if (bound > max_column - other.bound) {
+          auto normalized = other;
+          normalized.normalize();
+          return *this += normalized;
+        }
+      }
+      for (std::size_t sign = 0; sign < 2; sign++) {
+        if (columns[sign].size() < other.columns[sign].size()) {
+          columns[sign].resize(other.columns[sign].size(), 0);
+        }
+        for (std::size_t i = 0; i < other.columns[sign].size(); i++) {
+          columns[sign][i] += other.columns[sign][i];
+        }
+      }
+      bound += other.bound;
+      return *this;
+    }
+    // the sum so far; propagates the pending carries (which is why it is not
+    // const) but the accumulator keeps going afterwards
+    Large_Numbers Result() {
+      normalize();
+      auto result = Large_Numbers(to_limbs(columns[0]), true);
+      result -= Large_Numbers(to_limbs(columns[1]), true);
+      return result;
     }
-    // strip the trailing 0's and we'll get a multiplier
-    auto zero_index = num_zeros;
-    while (zero_index > 0) {
-      multiplier.pop_back();
-      zero_index--;
+    void Clear() {
+      columns[0].clear();
+      columns[1].clear();
+      bound = 0;
     }
-  }
 
-  // We need comparitors for the vector<uint32_t>
-  bool op_equal(const int_revvec_t &lhs, const int_revvec_t &rhs) const {
-    if (lhs != rhs) {
-      // usually, the built-in version is optimized and faster than manual
-      return false;
+  private:
+    static std::uint64_t magnitude_of(const std::int64_t &value) {
+      // well defined for INT64_MIN too, unlike -value
+      return value < 0 ? 0 - static_cast<std::uint64_t>(value)
+                       : static_cast<std::uint64_t>(value);
     }
-    if (lhs.size() != rhs.size()) {
-      return false;
+    Accumulator &add_small(const std::int64_t &term, bool subtract) {
+      auto magnitude = magnitude_of(term);
+      auto limbs = std::array<limb_t, 3>{};
+      auto size = std::size_t(0);
+      for (; magnitude > 0; magnitude /= LIMB_BASE) {
+        limbs[size++] = static_cast<limb_t>(magnitude % LIMB_BASE);
+      }
+      add_limbs(limbs.data(), size, 1, 0, (term < 0) != subtract);
+      return *this;
     }
-    for (int i = 0; i < lhs.size(); i++) {
-      if (lhs[i] != rhs[i]) {
-        return false;
+    // columns[negative][shift + i] += limbs[i] * multiplier
+    void add_limbs(const limb_t *limbs, std::size_t size,
+                   std::uint64_t multiplier, std::size_t shift, bool negative) {
+      auto increment = (LIMB_BASE - 1) * multiplier;
+      if (bound > max_column - increment) {
+        normalize();
+      }
+      bound += increment;
+      auto &column = columns[negative ? 1 : 0];
+      if (column.size() < shift + size) {
+        column.resize(shift + size, 0);
+      }
+      auto target = column.data() + shift;
+      for (std::size_t i = 0; i < size; i++) {
+        target[i] += limbs[i] * multiplier;
       }
     }
-    return true;
-  }
-  bool op_equal_tup(
-      const std::tuple<bool /*sign*/, int_revvec_t /*digits*/> &lhs,
-      const std::tuple<bool /*sign*/, int_revvec_t /*digits*/> &rhs) const {
-    if (std::get<1>(lhs).size() != std::get<1>(rhs).size()) {
-      return false;
+    // propagates the carries so that every column is < 10^9 again
+    void normalize() {
+      for (auto &column : columns) {
+        auto carry = std::uint64_t(0);
+        for (auto &limb : column) {
+          carry += limb;
+          limb = carry % LIMB_BASE;
+          carry /= LIMB_BASE;
+        }
+        for (; carry > 0; carry /= LIMB_BASE) {
+          column.push_back(carry % LIMB_BASE);
+        }
+      }
+      bound = LIMB_BASE - 1;
+    }
+    static int_revvec_t to_limbs(const std::vector<std::uint64_t> &column) {
+      auto limbs = int_revvec_t(std::max<std::size_t>(column.size(), 1), 0);
+      std::copy(column.begin(), column.end(), limbs.begin());
+      trim_limbs(limbs);
+      return limbs;
     }
-    return op_equal(std::get<1>(lhs), std::get<1>(rhs));
+
+    // columns stay below this so that normalize() can add the carry from the
+    // column below (at most max / 10^9) without wrapping around
+    static constexpr std::uint64_t max_column =
+        std::numeric_limits<std::uint64_t>::max() -
+        std::numeric_limits<std::uint64_t>::max() / LIMB_BASE;
+
+    std::array<std::vector<std::uint64_t>, 2> columns; // {positive, negative}
+    std::uint64_t bound = 0; // no column is above this
+  };
+
+  // division AND remainder in one go, so that doing a % b right after a / b
+  // does not redo the division; like C++'s built-in / and %, the quotient is
+  // truncated towards zero and the remainder has the sign of the dividend
+  // (i.e. -7 / 2 = -3 and -7 % 2 = -1)
+  std::tuple<Large_Numbers /*quotient*/, Large_Numbers /*remainder*/>
+  divmod(const Large_Numbers &rhs) const {
+    auto result = op_divide(this->value, rhs.value);
+    auto quotient = Large_Numbers(std::move(std::get<0>(result)),
+                                  this->is_positive == rhs.is_positive);
+    auto remainder =
+        Large_Numbers(std::move(std::get<1>(result)), this->is_positive);
+    quotient.is_positive = quotient.is_positive || quotient.Is_Zero();
+    remainder.is_positive = remainder.is_positive || remainder.Is_Zero();
+    return {std::move(quotient), std::move(remainder)};
+  }
+  // base^exp by left-to-right sliding window (see op_sliding_window()); the
+  // squarings, which are most of the work, go through op_square()
+  static Large_Numbers pow(const Large_Numbers &base,
+                           const std::uint64_t &exp) {
+    auto result = op_sliding_window(
+        Large_Numbers(base.value, true), Large_Numbers(vec_one, true),
+        exponent_bits(exp), [](const Large_Numbers &x) { return x * x; },
+        [](const Large_Numbers &x, const Large_Numbers &y) { return x * y; });
+    result.is_positive = base.is_positive || (exp & 1) == 0;
+    result.is_positive = result.is_positive || result.Is_Zero();
+    return result;
+  }
+  // base^exp mod modulus, in [0, modulus) (so a negative base is taken
+  // modulo modulus first); needs exp >= 0 and modulus > 0.  The sliding
+  // window runs on Mod_Context residues (Montgomery or Barrett), so the only
+  // full divisions are the couple needed to set it up and to get the base
+  // into its domain
+  static Large_Numbers modpow(const Large_Numbers &base,
+                              const Large_Numbers &exp,
+                              const Large_Numbers &modulus) {
+    auto context = Mod_Context(modulus);
+    return context.Reduce(base).Pow(exp).Value();
   }
 
-  bool op_less_than(const int_revvec_t lhs, const int_revvec_t rhs) const {
-    if (lhs < rhs) {
-      // usually, the built-in version is optimized and faster than manual
-      return true;
+private:
+  // modular multiplication engine behind Mod_Context: residues modulo a fixed
+  // modulus m (n limbs) are trimmed vectors < m, multiplied and reduced
+  // without a division, in place and with per-thread scratch buffers so
+  // that a long chain of operations does not allocate:
+  // * Montgomery, when m is coprime to 10 (the limb base B = 10^9 has to be
+  //   invertible mod m, the base 10 analogue of "m is odd") and narrower
+  //   than Modular_Thresholds::barrett: residues are kept as x * R mod m
+  //   (R = B^n), and the product is interleaved with REDC one limb at a
+  //   time, every step adding the multiple of m that zeroes the lowest limb
+  // * Barrett otherwise: with mu = floor(B^2n / m) precomputed, two
+  //   multiplications estimate the quotient of x < m^2 at most 2 short
+  class Modular_Reducer {
+  public:
+    explicit Modular_Reducer(const int_revvec_t &modulus)
+        : modulus(modulus), size(modulus.size()),
+          montgomery(modulus[0] % 2 != 0 && modulus[0] % 5 != 0 &&
+                     modulus.size() < Modular_Thresholds::barrett) {
+      if (montgomery) {
+        // m0 * inverse = 1 (mod 10) from a table, then Newton's
+        // inverse = inverse * (2 - m0 * inverse) doubles the number of
+        // correct digits each round: 2, 4, 8, 16 >= 9
+        constexpr limb_t inverse_mod_10[10] = {0, 1, 0, 7, 0, 0, 0, 3, 0, 9};
+        double_limb_t inverse = inverse_mod_10[modulus[0] % 10];
+        for (std::size_t round = 0; round < 4; round++) {
+          auto product = (double_limb_t)modulus[0] * inverse % LIMB_BASE;
+          inverse = inverse * ((2 + LIMB_BASE - product) % LIMB_BASE) %
+                    LIMB_BASE;
+        }
+        m_prime = (limb_t)((LIMB_BASE - inverse) % LIMB_BASE);
+      } else {
+        mu = std::get<0>(
+            op_divide(op_shift_limbs_left(vec_one, 2 * size), modulus));
+      }
+      one = To_Domain(vec_one);
     }
-    if (lhs.size() != rhs.size()) {
-      return lhs.size() < rhs.size();
+    // x (any magnitude) into the domain, and a residue back out of it
+    int_revvec_t To_Domain(const int_revvec_t &x) const {
+      if (montgomery) {
+        return std::get<1>(op_divide(op_shift_limbs_left(x, size), modulus));
+      }
+      if (x.size() > 2 * size) {
+        return std::get<1>(op_divide(x, modulus));
+      }
+      auto result = int_revvec_t();
+      barrett(x.data(), x.size(), result);
+      return result;
     }
-    for (int i = 0; i < lhs.size(); i++) {
-      if (lhs[i] != rhs[i]) {
-        return lhs[i] < rhs[i];
+    int_revvec_t From_Domain(const int_revvec_t &x) const {
+      auto result = x;
+      if (montgomery) {
+        montgomery_multiply(result, vec_one); // x * 1 / R
       }
+      return result;
     }
-    return false;
-  }
-  bool op_less_than_tup(
-      const std::tuple<bool /*sign*/, int_revvec_t /*digits*/> &lhs,
-      const std::tuple<bool /*sign*/, int_revvec_t /*digits*/> &rhs) const {
-    return op_less_than(std::get<1>(lhs), std::get<1>(rhs));
-  }
-
-  // subtaction based assumptions that left is >= right AND both
-  // left AND right are POSITIVE numbers
-  // See op_subtract_tuple for signed subtraction
-  int_revvec_t op_subtract(const int_revvec_t &lhs,
-                           const int_revvec_t &rhs) const {
-    // std::cout << "op_subtract:" << std::endl;
-    // std::cout << "\tleft:  ";
-    // dump_digits(lhs);
-    // std::cout << std::endl;
-    // std::cout << "\tright: ";
-    // dump_digits(rhs);
-    // std::cout << std::endl;
-
-    // for subtraction, the most obvious is to check if left == right
-    if (op_equal(lhs, rhs)) {
-      // std::cout << "\top_subtract result (zero): ";
-      // dump_digits(vec_zero);
-      // std::cout << std::endl;
-
-      return vec_zero;
-    }
-    // another obvious is if either is 0 (but because we assume lhs > rhs, we
-    // only need to check rhs)
-    if ((rhs.size() == 0) || (rhs.size() == 1 && rhs[0] == 0)) {
-      // std::cout << "\top_subtract result (rhs==0, returning lhs-as-is): ";
-      // dump_digits(lhs);
-      // std::cout << std::endl;
-
-      return lhs;
+    // x = x * y in the domain; y may be x itself (which makes it a square)
+    void Multiply(int_revvec_t &x, const int_revvec_t &y) const {
+      if (montgomery) {
+        montgomery_multiply(x, y);
+        return;
+      }
+      // thread_local buffers are moved out while in use here and in the
+      // helpers below: op_multiply() may fork and run stolen tasks that
+      // reduce on this thread too
+      static thread_local int_revvec_t product_scratch(
+          std::pmr::get_default_resource());
+      auto product = std::move(product_scratch);
+      product.resize(x.size() + y.size());
+      op_multiply(x.data(), x.size(), y.data(), y.size(), product.data());
+      barrett(product.data(), product.size(), x);
+      product_scratch = std::move(product);
+    }
+    int_revvec_t Multiply(const int_revvec_t &lhs,
+                          const int_revvec_t &rhs) const {
+      auto result = lhs;
+      Multiply(result, &lhs == &rhs ? result : rhs);
+      return result;
     }
+    const int_revvec_t &One() const { return one; }
+    const int_revvec_t &Modulus() const { return modulus; }
+    bool Is_Montgomery() const { return montgomery; }
 
-    // first, clone so that we can reverse it
-    auto left_clone = lhs;
-    auto right_clone = rhs;
-    // we won't eve throw, we will ASSUME left > right (we already checked if
-    // equal)
-    // 87654
-    // - 780
-    // =====
-    // ((4 - 0) +  0) - 0 = 4 (no borrow)
-    // ((5 - 0) + 10) - 8 = 7 (borrow from next digit)
-    // ((6 - 1) + 10) - 7 = 8 (borrow from next digit)
-    // ((7 - 1) +  0) - 0 = 6 (no borrow)
-    // ((8 - 0) +  0) - 0 = 8 (no borrow)
-    // 87654 - 780 = 86874
-    // we'll update left-clone in-place
-    int32_t borrow = 0; // 0 if previous did not borrow, 1 if it was borrowed
-    for (auto left_index = 0; left_index < left_clone.size(); left_index++) {
-      // if rhs.size() < left_index, just use 0 since (lhs - 0 = lhs)
-      int32_t right_digit = (left_index < right_clone.size())
-                                ? (int32_t)right_clone[left_index]
-                                : 0;
-      int32_t left_digit = (int32_t)left_clone[left_index] - borrow;
-      if ((left_digit < 0) || (left_digit < right_digit)) {
-        // we'll need to borrow again
-        left_digit += 10; // borrow
-        borrow = 1;       // we borrowed
-      } else {
-        borrow = 0; // we did not need to borrow
+  private:
+    // x = x * y / R mod m: the product (a square when y is x) goes through
+    // op_multiply(), then REDC adds, for each of its n lowest limbs, the
+    // multiple u * m of the modulus that zeroes it, and drops those n limbs
+    void montgomery_multiply(int_revvec_t &x, const int_revvec_t &y) const {
+      static thread_local int_revvec_t t_scratch(
+          std::pmr::get_default_resource());
+      auto t = std::move(t_scratch);
+      t.resize(x.size() + y.size());
+      op_multiply(x.data(), x.size(), y.data(), y.size(), t.data());
+      t.resize(2 * size + 1, 0);
+      for (std::size_t i = 0; i < size; i++) {
+        double_limb_t u = (double_limb_t)t[i] * m_prime % LIMB_BASE;
+        if (u == 0) {
+          continue;
+        }
+        double_limb_t carry = 0;
+        for (std::size_t j = 0; j < size; j++) {
+          double_limb_t sum = t[i + j] + u * modulus[j] + carry;
+          carry = sum / LIMB_BASE;
+          t[i + j] = (limb_t)(sum - carry * LIMB_BASE);
+        }
+        for (auto k = i + size; carry > 0; k++) {
+          double_limb_t sum = t[k] + carry;
+          carry = sum / LIMB_BASE;
+          t[k] = (limb_t)(sum - carry * LIMB_BASE);
+        }
+      }
+      x.assign(t.begin() + size, t.end());
+      t_scratch = std::move(t);
+      trim_limbs(x);
+      if (op_compare(x, modulus) >= 0) {
+        op_subtract_at(x.data(), x.size(), modulus.data(), modulus.size());
+        trim_limbs(x);
       }
-      left_clone[left_index] = left_digit - right_digit;
     }
-    // finally, if borrow is still 1, then something went wrong, because we have
-    // already checked that lhs > rhs
-    if (borrow == 1) {
-      std::clog << "Borrow is still 1 after subtraction" << std::endl;
-      throw std::invalid_argument("Borrow is still 1 after subtraction");
-    } else {
-      // trim: remove the last digit if it's 0 (43210 , strip it to 4321)
-      while (left_clone.back() == 0) {
-        left_clone.pop_back();
-      }
-    }
-
-    return left_clone;
-  }
-
-  // Note: unlike the other excercise, we'll add IN-PLACE so we do
-  // not need to mess with any carry-over values
-  int_revvec_t op_add(const int_revvec_t &lhs, const int_revvec_t &rhs) const {
-    // std::cout << "op_add:" << std::endl;
-    // std::cout << "\tleft:  ";
-    // dump_digits(lhs);
-    // std::cout << std::endl;
-    // std::cout << "\tright: ";
-    // dump_digits(rhs);
-    // std::cout << std::endl;
-
-    // first, clone so that we can reverse it
-    auto left_clone = lhs.size() > rhs.size() ? lhs : rhs;
-    auto right_clone = lhs.size() > rhs.size() ? rhs : lhs;
-
-    // as tempting it is to check if rhs is just single digit, it can become a
-    // carry-over chained reaction if lhs is 999...9999 and rhs > 0...  lhs==0
-    // is the only special case we'll handle if either is val[0] == 0 (or
-    // empty), just return the other since we know that lhs is always wider than
-    // rhs, we can just check rhs for width
-    if ((right_clone.size() == 0) ||
-        (right_clone.size() == 1 && right_clone[0] == 0)) {
-      // std::cout << "\top_add result (rhs==0, returning lhs-as-is): ";
-      // dump_digits(left_clone);
-      // std::cout << std::endl;
-
-      return left_clone;
-    }
-
-    // 87654
-    // 91239
-    // =====
-    // (4 + 9) = 13 = 3 (carry-over 1)
-    // (5 + 3) + 1 = 9 (carry-over 0)
-    // (6 + 2) = 8 (carry-over 0)
-    // (7 + 1) = 8 (carry-over 0)
-    // 8 + 9 = 17 = 7 (carry-over 1)
-    // 91239 (5 digits) + 87654 (5 digits) = 178893 (6 digits)
-    for (auto left_index = 0; left_index < left_clone.size(); left_index++) {
-      // add and carry-over if needed; Note that because we use u8 type instead
-      // of char '0'..'9' we can actually add in place (i.e. 9 + 4 = 13) and
-      // then just subtract 10 if >= 10
-      if (left_index < right_clone.size()) {
-        // make sure right[i] exists...
-        left_clone[left_index] += right_clone[left_index];
-      }
-
-      // TODO: some reason, when I do 'if (left_clone[left_index] >= 10)' it
-      //       doesn't work and I have to preset my carry over - figure out why
-      auto carry_over = left_clone[left_index] / 10; // 23 / 10 = 2
-      if (carry_over > 0) {
-        left_clone[left_index] = left_clone[left_index] % 10; // 23 % 10 = 3
-        // if it's the last digit, we have to add a new digit, else +1 to next
-        // digit.  We shouldn't have to do the push_back since we resized it
-        // (left_clone.size()) earlier, but just in case, we'll leave this extra
-        // check so that when I port this to rust, it'l be a reminder...
-        if (left_index + 1 < left_clone.size()) {
-          left_clone[left_index + 1] += carry_over;
-        } else {
-          try {
-            // if we're at the end, we'll just push_back the carry_over
-            left_clone.push_back(carry_over);
-          } catch (const std::exception &e) {
-            std::clog << "Exception: " << e.what() << std::endl;
-            std::clog << "left_index: " << left_index
-                      << ", left_clone.size(): " << left_clone.size()
-                      << ", carry_over: " << carry_over << std::endl;
-          }
+    // result = x mod m, for x < B^2n (x must not be result's own limbs)
+    void barrett(const limb_t *x, std::size_t x_size,
+                 int_revvec_t &result) const {
+      static thread_local int_revvec_t estimate_scratch(
+          std::pmr::get_default_resource());
+      static thread_local int_revvec_t multiple_scratch(
+          std::pmr::get_default_resource());
+      auto estimate = std::move(estimate_scratch);
+      auto multiple = std::move(multiple_scratch);
+      x_size = std::max<std::size_t>(significant_size(x, x_size), 1);
+      result.assign(x, x + x_size);
+      if (x_size >= size) {
+        // quotient ~ floor(floor(x / B^(n-1)) * mu / B^(n+1))
+        auto high_size = x_size - (size - 1);
+        estimate.resize(high_size + mu.size());
+        op_multiply(x + size - 1, high_size, mu.data(), mu.size(),
+                    estimate.data());
+        if (estimate.size() > size + 1) {
+          auto quotient_size = estimate.size() - (size + 1);
+          multiple.resize(quotient_size + size);
+          op_multiply(estimate.data() + size + 1, quotient_size,
+                      modulus.data(), size, multiple.data());
+          op_subtract_at(result.data(), result.size(), multiple.data(),
+                         multiple.size());
+          trim_limbs(result);
         }
       }
+      estimate_scratch = std::move(estimate);
+      multiple_scratch = std::move(multiple);
+      while (op_compare(result, modulus) >= 0) {
+        op_subtract_at(result.data(), result.size(), modulus.data(), size);
+        trim_limbs(result);
+      }
     }
 
-    // trim: remove the last digit if it's 0 (43210 , strip it to 4321)
-    while (left_clone.back() == 0) {
-      left_clone.pop_back();
-    }
+    int_revvec_t modulus;
+    std::size_t size;
+    bool montgomery;
+    limb_t m_prime = 0;                // -m^-1 mod B (Montgomery)
+    int_revvec_t mu = int_revvec_t{0}; // floor(B^2n / m) (Barrett)
+    int_revvec_t one;                  // 1 in the domain
+  };
 
-    return left_clone;
-  }
+public:
+  // Arithmetic modulo a fixed modulus m > 0, for long chains of operations:
+  // the Montgomery/Barrett constants are computed once, and residues stay
+  // reduced (and, for Montgomery, in Montgomery form) through +, -, * and
+  // Pow(), so no operation needs a division; only Reduce() (into the
+  // domain) and Value() (back out of it) convert.  i.e.
+  //
+  //    auto context = Large_Numbers::Mod_Context(modulus);
+  //    auto x = context.Reduce(a), y = context.Reduce(b);
+  //    for (...) {
+  //      x = x * x + y;
+  //    }
+  //    auto result = x.Value(); // in [0, modulus)
+  //
+  // Residues point back to their context, which must outlive them (hence
+  // it cannot be copied or moved); mixing residues of different contexts
+  // throws
+  class Mod_Context {
+  public:
+    class Residue {
+    public:
+      Residue &operator+=(const Residue &rhs) {
+        check_context(rhs);
+        auto &modulus = context->reducer.Modulus();
+        value.resize(std::max(value.size(), rhs.value.size()) + 1, 0);
+        op_add_at(value.data(), value.size(), rhs.value.data(),
+                  rhs.value.size());
+        trim_limbs(value);
+        if (op_compare(value, modulus) >= 0) {
+          op_subtract_at(value.data(), value.size(), modulus.data(),
+                         modulus.size());
+          trim_limbs(value);
+        }
+        return *this;
+      }
+      Residue &operator-=(const Residue &rhs) {
+        check_context(rhs);
+        if (op_compare(value, rhs.value) < 0) {
+          // x - y = x + (m - y), which is < m since x < y
+          auto &modulus = context->reducer.Modulus();
+          value.resize(modulus.size() + 1, 0);
+          op_add_at(value.data(), value.size(), modulus.data(),
+                    modulus.size());
+        }
+        op_subtract_at(value.data(), value.size(), rhs.value.data(),
+                       rhs.value.size());
+        trim_limbs(value);
+        return *this;
+      }
+      Residue &operator*=(const Residue &rhs) {
+        check_context(rhs);
+        context->reducer.Multiply(value, rhs.value);
+        return *this;
+      }
+      Residue operator+(const Residue &rhs) const {
+        auto result = *this;
+        return result += rhs;
+      }
+      Residue operator-(const Residue &rhs) const {
+        auto result = *this;
+        return result -= rhs;
+      }
+      Residue operator*(const Residue &rhs) const {
+        auto result = *this;
+        return &rhs == this ? result *= result : result *= rhs;
+      }
+      Residue operator-() const { return context->Zero() - *this; }
+      bool operator==(const Residue &rhs) const {
+        return context == rhs.context && op_equal(value, rhs.value);
+      }
+      // this^exp (exp >= 0) by sliding window, see op_sliding_window()
+      Residue Pow(const Large_Numbers &exp) const {
+        if (!exp.Is_Positive()) {
+          throw std::invalid_argument("Exponent must be >= 0");
+        }
+        auto &reducer = context->reducer;
+        return Residue(
+            context,
+            op_sliding_window(
+                value, reducer.One(), exponent_bits(exp.value),
+                [&](const int_revvec_t &x) { return reducer.Multiply(x, x); },
+                [&](const int_revvec_t &x, const int_revvec_t &y) {
+                  return reducer.Multiply(x, y);
+                }));
+      }
+      // back out of the domain, in [0, modulus)
+      Large_Numbers Value() const {
+        return Large_Numbers(context->reducer.From_Domain(value), true);
+      }
 
-  std::tuple<bool /*is_positive*/, int_revvec_t /*digits*/> op_add_tuple(
-      std::tuple<bool /*is_positive*/, int_revvec_t /*digits*/> left,
-      std::tuple<bool /*is_positive*/, int_revvec_t /*digits*/> right) const {
-    // std::cout << "op_add_tuple:" << std::endl;
-    // std::cout << "\tleft (is_positive=" << std::get<0>(left) << ")  :";
-    // dump_digits(left);
-    // std::cout << std::endl;
-    // std::cout << "\tright (is_positive=" << std::get<0>(right) << ") :";
-    // dump_digits(right);
-    // std::cout << std::endl;
+    private:
+      friend class Mod_Context;
+      Residue(const Mod_Context *context, int_revvec_t value)
+          : context(context), value(std::move(value)) {}
+      void check_context(const Residue &rhs) const {
+        if (context != rhs.context) {
+          throw std::invalid_argument(
+              "Residues belong to different Mod_Contexts");
+        }
+      }
 
-    // if lhs > 0, rhs > 0, just add both
-    if (std::get<0>(left) && std::get<0>(right)) {
-      // std::cout << "\tboth positive..." << std::endl;
-      //  NOTE: op_add() pretests for lesser-of-the-two == 0
-      auto result = op_add(std::get<1>(left), std::get<1>(right));
-      // both are positive, so result is positive
-      return {true, result};
-    }
+      const Mod_Context *context;
+      int_revvec_t value; // < modulus, in the reducer's domain
+    };
 
-    // if lhs < 0, rhs > 0, swap and subtract
-    else if (!std::get<0>(left) && std::get<0>(right)) {
-      // std::cout << "\tleft negative, right positive..." << std::endl;
-      auto result = op_subtract(std::get<1>(right), std::get<1>(left));
-      // if rhs >= lhs, then result is positive, else negative
-      return {op_less_than(std::get<1>(right), std::get<1>(left)), result};
-    }
+    explicit Mod_Context(const Large_Numbers &modulus)
+        : reducer(checked_modulus(modulus)) {}
+    Mod_Context(const Mod_Context &) = delete;
+    Mod_Context &operator=(const Mod_Context &) = delete;
 
-    // if lhs > 0, rhs < 0, just subtract
-    else if (std::get<0>(left) && !std::get<0>(right)) {
-      // std::cout << "\tleft positive, right negative..." << std::endl;
-      auto result = op_subtract(std::get<1>(left), std::get<1>(right));
-      // if lhs >= rhs, then result is positive, else negative
-      return {op_less_than(std::get<1>(left), std::get<1>(right)), result};
+    // x mod modulus (in [0, modulus) even for a negative x) as a residue;
+    // this is the one place that divides
+    Residue Reduce(const Large_Numbers &x) const {
+      auto &modulus = reducer.Modulus();
+      auto magnitude = std::get<1>(op_divide(x.value, modulus));
+      if (!x.is_positive && !(magnitude.size() == 1 && magnitude[0] == 0)) {
+        magnitude = op_subtract_limbs(modulus, magnitude);
+      }
+      return Residue(this, reducer.To_Domain(magnitude));
+    }
+    Residue Zero() const { return Residue(this, int_revvec_t{0}); }
+    Residue One() const { return Residue(this, reducer.One()); }
+    Large_Numbers Modulus() const {
+      return Large_Numbers(reducer.Modulus(), true);
+    }
+    bool Is_Montgomery() const { return reducer.Is_Montgomery(); }
+
+  private:
+    static const int_revvec_t &checked_modulus(const Large_Numbers &modulus) {
+      if (!modulus.Is_Positive() || modulus.Is_Zero()) {
+        throw std::invalid_argument("Modulus must be > 0");
+      }
+      return modulus.value;
+    }
+
+    Modular_Reducer reducer;
+  };
+
+  // greatest common divisor, always >= 0 (and gcd(0, 0) = 0).  The operands
+  // are reduced by half-GCD while they are wide, Lehmer steps (a whole
+  // batch of Euclid quotients found from the leading 2 limbs, then applied
+  // at once) while they have a few limbs, and binary GCD once they fit in
+  // 64 bits; see op_gcd_reduce()
+  static Large_Numbers gcd(const Large_Numbers &a, const Large_Numbers &b) {
+    auto lhs = Large_Numbers(a.value, true);
+    auto rhs = Large_Numbers(b.value, true);
+    if (op_compare(lhs.value, rhs.value) < 0) {
+      std::swap(lhs, rhs);
+    }
+    op_gcd_reduce(lhs, rhs, 2, nullptr);
+    if (rhs.Is_Zero()) {
+      return lhs;
+    }
+    if (lhs.value.size() > 2) {
+      op_gcd_division_step(lhs, rhs, nullptr); // |rhs| fits in 64 bits
+    }
+    return Large_Numbers(
+        u64_to_limbs(binary_gcd(limbs_to_u64(lhs.value),
+                                limbs_to_u64(rhs.value))),
+        true);
+  }
+  // {g, x, y} with a * x + b * y = g = gcd(a, b), from the same reduction as
+  // gcd() but with the (unimodular) transformation matrix kept along
+  static std::tuple<Large_Numbers /*gcd*/, Large_Numbers /*x*/,
+                    Large_Numbers /*y*/>
+  xgcd(const Large_Numbers &a, const Large_Numbers &b) {
+    auto lhs = Large_Numbers(a.value, true);
+    auto rhs = Large_Numbers(b.value, true);
+    auto swapped = op_compare(lhs.value, rhs.value) < 0;
+    if (swapped) {
+      std::swap(lhs, rhs);
+    }
+    auto matrix = identity_matrix();
+    op_gcd_reduce(lhs, rhs, 0, &matrix);
+    // lhs = matrix[0] * |a| + matrix[1] * |b| (before the swap)
+    auto x = std::move(matrix[swapped ? 1 : 0]);
+    auto y = std::move(matrix[swapped ? 0 : 1]);
+    if (!a.is_positive) {
+      x = -x;
+    }
+    if (!b.is_positive) {
+      y = -y;
+    }
+    return {std::move(lhs), std::move(x), std::move(y)};
+  }
+  // a^-1 mod modulus, in [0, modulus); throws if gcd(a, modulus) != 1
+  static Large_Numbers modinv(const Large_Numbers &a,
+                              const Large_Numbers &modulus) {
+    if (!modulus.Is_Positive() || modulus.Is_Zero()) {
+      throw std::invalid_argument("Modulus must be > 0");
+    }
+    auto [g, x, y] = xgcd(a % modulus, modulus);
+    if (!op_equal(g.value, vec_one)) {
+      if (op_equal(modulus.value, vec_one)) {
+        return Zero(); // everything is 0 (and its own inverse) mod 1
+      }
+      throw std::invalid_argument("Not invertible modulo modulus");
+    }
+    x %= modulus;
+    if (!x.is_positive) {
+      x += modulus;
+    }
+    return x;
+  }
+  // floor(sqrt(n)), n >= 0; see op_root()
+  static Large_Numbers isqrt(const Large_Numbers &n) { return iroot(n, 2); }
+  // the k-th root of n rounded towards zero (k >= 1, and n >= 0 unless k is
+  // odd), computed by Newton iteration that doubles its precision: the root
+  // of the leading limbs, found the same way, seeds the iteration for the
+  // full number, so the total is a small constant times one division (and
+  // one k-th power) at full size
+  static Large_Numbers iroot(const Large_Numbers &n, const std::uint64_t &k) {
+    if (k == 0) {
+      throw std::invalid_argument("Root degree must be >= 1");
+    }
+    if (!n.Is_Positive() && (k & 1) == 0) {
+      throw std::invalid_argument("Even root of a negative number");
+    }
+    auto root = op_root(Large_Numbers(n.value, true), k);
+    root.is_positive = n.Is_Positive() || root.Is_Zero();
+    return root;
+  }
+  // most non-squares are rejected from their residues mod 512 (straight from
+  // the lowest limb, as 512 divides 10^9) and mod 63 * 65 * 11 (one
+  // op_modulo_limb() pass), which only about 1 in 100 non-squares survive;
+  // only those get their square root computed
+  static bool is_perfect_square(const Large_Numbers &n) {
+    if (!n.Is_Positive()) {
+      return false;
+    }
+    if (!square_residues<512>()[n.value[0] % 512]) {
+      return false;
+    }
+    auto residue = op_modulo_limb(n.value.data(), n.value.size(), 63 * 65 * 11);
+    if (!square_residues<63>()[residue % 63] ||
+        !square_residues<65>()[residue % 65] ||
+        !square_residues<11>()[residue % 11]) {
+      return false;
+    }
+    auto root = op_root(n, 2);
+    return op_equal((root * root).value, n.value);
+  }
+
+  // fast path for dividing by a machine word (i.e. n / 10 for digit sums, or
+  // any divisor < 2^32), only a single pass over the limbs
+  std::tuple<Large_Numbers /*quotient*/, std::int64_t /*remainder*/>
+  divmod_small(const std::uint32_t &divisor) const {
+    if (divisor == 0) {
+      throw std::invalid_argument("Division by zero");
+    }
+    auto quotient = *this;
+    std::int64_t remainder =
+        op_divide_limb(quotient.value.data(), quotient.value.size(), divisor);
+    quotient.trim();
+    quotient.is_positive = this->is_positive || quotient.Is_Zero();
+    return {quotient, this->is_positive ? remainder : -remainder};
+  }
+
+private:
+  // we do not allow NaN
+  Large_Numbers() : value(vec_zero), is_positive(true) {}
+  Large_Numbers(int_revvec_t v, bool is_positive)
+      : value(std::move(v)), is_positive(is_positive) {}
+  Large_Numbers(int_revvec_t v) : value(std::move(v)), is_positive(true) {}
+
+  // copy of source whose buffer already has room for capacity limbs, so that
+  // the in-place compound operators never need to grow it
+  static Large_Numbers with_capacity(const Large_Numbers &source,
+                                     std::size_t capacity) {
+    auto result = Large_Numbers(int_revvec_t(), source.is_positive);
+    result.value.reserve(capacity);
+    result.value.assign(source.value.begin(), source.value.end());
+    return result;
+  }
+  void negate() { this->is_positive = !this->is_positive || this->Is_Zero(); }
+  void reset_to_zero() {
+    this->value.clear();
+    this->value.push_back(0);
+    this->is_positive = true;
+  }
+
+public:
+  Large_Numbers(const Large_Numbers &) = default;
+  // a moved-from number is left as 0 (one inline limb, no allocation), so it
+  // still holds the "at least one limb" every operation relies on
+  Large_Numbers(Large_Numbers &&other) noexcept
+      : value(std::move(other.value)), is_positive(other.is_positive) {
+    other.reset_to_zero();
+  }
+  Large_Numbers &operator=(const Large_Numbers &) = default;
+  Large_Numbers &operator=(Large_Numbers &&other) {
+    if (this != &other) {
+      this->value = std::move(other.value);
+      this->is_positive = other.is_positive;
+      other.reset_to_zero();
+    }
+    return *this;
+  }
+
+  // While alive, numbers constructed on this thread take their limb buffers
+  // from resource (e.g. a std::pmr::unsynchronized_pool_resource), then the
+  // previous resource is restored.  Scopes nest, and must be destroyed in
+  // reverse order of construction (which is what RAII gives you anyway)
+  class Memory_Resource_Scope {
+  public:
+    explicit Memory_Resource_Scope(std::pmr::memory_resource *resource)
+        : previous(Limb_Vector::thread_resource) {
+      Limb_Vector::thread_resource = resource;
+    }
+    ~Memory_Resource_Scope() { Limb_Vector::thread_resource = previous; }
+    Memory_Resource_Scope(const Memory_Resource_Scope &) = delete;
+    Memory_Resource_Scope &operator=(const Memory_Resource_Scope &) = delete;
+
+    // the resource that was current before this scope
+    std::pmr::memory_resource *Previous() const {
+      return previous != nullptr ? previous : std::pmr::get_default_resource();
+    }
+
+  private:
+    std::pmr::memory_resource *previous;
+  };
+
+  // Bump allocator for a whole computation: every temporary created on this
+  // thread while the Arena is alive is carved out of one growing buffer and
+  // nothing is freed until the Arena goes away, at which point it is all
+  // released at once.  Numbers created inside MUST NOT outlive it, use Keep()
+  // to copy the result(s) out first:
+  //
+  //    Large_Numbers result = Large_Numbers::Zero();
+  //    {
+  //      Large_Numbers::Arena arena;
+  //      auto temporary = ...;    // lots of short-lived expressions
+  //      result = arena.Keep(temporary);
+  //    }
+  //
+  // Since it never reuses memory, a long loop will keep on growing it; in
+  // that case prefer a pool resource with Memory_Resource_Scope instead
+  class Arena {
+  public:
+    explicit Arena(std::size_t initial_bytes = 64 * 1024)
+        : resource(initial_bytes), scope(&resource) {}
+    Arena(const Arena &) = delete;
+    Arena &operator=(const Arena &) = delete;
+
+    // deep copy of value whose buffer comes from outside of this arena
+    Large_Numbers Keep(const Large_Numbers &value) const {
+      auto kept = Large_Numbers(int_revvec_t(scope.Previous()),
+                                value.is_positive);
+      kept.value.assign(value.value.begin(), value.value.end());
+      return kept;
+    }
+
+  private:
+    std::pmr::monotonic_buffer_resource resource;
+    Memory_Resource_Scope scope;
+  };
+
+  // Binary serialization (version 1), every field little-endian:
+  //    offset  0: "LNUM"
+  //    offset  4: uint16 version
+  //    offset  6: uint16 flags, bit 0 is set when negative
+  //    offset  8: uint64 number of limbs (>= 1, most significant non-zero
+  //               unless the number is zero)
+  //    offset 16: the limbs, uint32 base 10^9, least significant first
+  // which is 4 bytes per 9 digits (against 9 for decimal text), and since
+  // it is the in-memory layout, a mapped file can be used as is (see View)
+  static constexpr std::uint16_t SERIAL_VERSION = 1;
+  static constexpr std::size_t SERIAL_HEADER_SIZE = 16;
+
+  std::size_t serialized_size() const {
+    return SERIAL_HEADER_SIZE + this->value.size() * sizeof(limb_t);
+  }
+  void serialize(std::ostream &os) const {
+    unsigned char header[SERIAL_HEADER_SIZE];
+    encode_serial_header(header, this->Is_Positive(), this->value.size());
+    os.write(reinterpret_cast<const char *>(header), SERIAL_HEADER_SIZE);
+    if constexpr (std::endian::native == std::endian::little) {
+      os.write(reinterpret_cast<const char *>(this->value.data()),
+               this->value.size() * sizeof(limb_t));
+    } else {
+      for (auto limb : this->value) {
+        unsigned char bytes[sizeof(limb_t)];
+        store_little_endian(bytes, limb, sizeof(limb_t));
+        os.write(reinterpret_cast<const char *>(bytes), sizeof(limb_t));
+      }
+    }
+  }
+  // throws std::invalid_argument on anything that is not a (complete)
+  // serialized number of a version we know
+  static Large_Numbers deserialize(std::istream &is) {
+    unsigned char header[SERIAL_HEADER_SIZE];
+    is.read(reinterpret_cast<char *>(header), SERIAL_HEADER_SIZE);
+    if (is.gcount() != static_cast<std::streamsize>(SERIAL_HEADER_SIZE)) {
+      throw std::invalid_argument("Truncated serialized number");
+    }
+    auto [is_positive, limb_count] = decode_serial_header(header);
+    // limb_count is untrusted, so the limbs are read in bounded chunks and
+    // the vector only grows as they actually arrive (a forged header cannot
+    // make us allocate more than one chunk past the end of the stream)
+    constexpr std::size_t chunk_limbs = std::size_t(1) << 16;
+    auto result = Large_Numbers(int_revvec_t(), is_positive);
+    while (result.value.size() < limb_count) {
+      auto offset = result.value.size();
+      auto count = std::min(limb_count - offset, chunk_limbs);
+      result.value.resize(offset + count);
+      auto bytes = static_cast<std::streamsize>(count * sizeof(limb_t));
+      is.read(reinterpret_cast<char *>(result.value.data() + offset), bytes);
+      if (is.gcount() != bytes) {
+        throw std::invalid_argument("Truncated serialized number");
+      }
+    }
+    if constexpr (std::endian::native != std::endian::little) {
+      for (auto &limb : result.value) {
+        limb = static_cast<limb_t>(load_little_endian(
+            reinterpret_cast<const unsigned char *>(&limb), sizeof(limb_t)));
+      }
+    }
+    for (auto limb : result.value) {
+      if (limb >= LIMB_BASE) {
+        throw std::invalid_argument("Limb out of range in serialized number");
+      }
+    }
+    check_canonical(result.value.data(), result.value.size());
+    result.is_positive = is_positive || result.Is_Zero(); // no "-0"
+    return result;
+  }
+
+  // Read-only number that points at serialized bytes rather than owning its
+  // limbs, i.e. a memory mapped file (see Mapped_File) of any size is
+  // "loaded" without reading, let alone copying, it.  It can be used as the
+  // right hand side of +, -, * (and their compound versions) directly, or
+  // be copied into a Large_Numbers.  The bytes MUST outlive the view.
+  // NOTE: only the header is checked up front, the limbs are trusted to be
+  // below 10^9 (use deserialize() for untrusted input)
+  class View {
+  public:
+    // throws std::invalid_argument if bytes is not a serialized number, and
+    // on big-endian hosts (where the limbs cannot be used in place)
+    static View From_Bytes(const void *bytes, std::size_t size) {
+      if constexpr (std::endian::native != std::endian::little) {
+        throw std::invalid_argument("View needs a little-endian host");
+      }
+      if (size < SERIAL_HEADER_SIZE) {
+        throw std::invalid_argument("Truncated serialized number");
+      }
+      auto header = static_cast<const unsigned char *>(bytes);
+      auto [is_positive, limb_count] = decode_serial_header(header);
+      if ((size - SERIAL_HEADER_SIZE) / sizeof(limb_t) < limb_count) {
+        throw std::invalid_argument("Truncated serialized number");
+      }
+      auto limbs = header + SERIAL_HEADER_SIZE;
+      if (reinterpret_cast<std::uintptr_t>(limbs) % alignof(limb_t) != 0) {
+        throw std::invalid_argument("Serialized limbs are misaligned");
+      }
+      auto view = View();
+      view.limbs = reinterpret_cast<const limb_t *>(limbs);
+      view.limb_count = limb_count;
+      check_canonical(view.limbs, view.limb_count);
+      view.is_positive =
+          is_positive || (limb_count == 1 && view.limbs[0] == 0);
+      return view;
+    }
+
+    bool Is_Positive() const { return this->is_positive; }
+    // number of decimal digits
+    std::size_t Size() const {
+      return (this->limb_count - 1) * LIMB_DIGITS +
+             std::to_string(this->limbs[this->limb_count - 1]).size();
+    }
+    Large_Numbers To_Large_Numbers() const {
+      return Large_Numbers(
+          int_revvec_t(this->limbs, this->limbs + this->limb_count),
+          this->is_positive);
+    }
+    std::string Get() const { return To_Large_Numbers().Get(); }
+
+  private:
+    friend class Large_Numbers;
+    View() = default;
+    const limb_t *limbs = nullptr;
+    std::size_t limb_count = 0;
+    bool is_positive = true;
+  };
+
+  explicit Large_Numbers(const View &view)
+      : Large_Numbers(view.To_Large_Numbers()) {}
+  Large_Numbers &operator+=(const View &rhs) {
+    add_in_place(rhs.limbs, rhs.limb_count, rhs.is_positive);
+    return *this;
+  }
+  Large_Numbers &operator-=(const View &rhs) {
+    add_in_place(rhs.limbs, rhs.limb_count, !rhs.is_positive);
+    return *this;
+  }
+  Large_Numbers &operator*=(const View &rhs) {
+    multiply_in_place(rhs.limbs, rhs.limb_count, rhs.is_positive);
+    return *this;
+  }
+  Large_Numbers operator+(const View &rhs) const {
+    auto result =
+        with_capacity(*this, std::max(this->value.size(), rhs.limb_count) + 1);
+    result += rhs;
+    return result;
+  }
+  Large_Numbers operator-(const View &rhs) const {
+    auto result =
+        with_capacity(*this, std::max(this->value.size(), rhs.limb_count) + 1);
+    result -= rhs;
+    return result;
+  }
+  Large_Numbers operator*(const View &rhs) const {
+    auto result = Large_Numbers(
+        int_revvec_t(this->value.size() + rhs.limb_count, 0),
+        this->is_positive == rhs.is_positive);
+    op_multiply(this->value.data(), this->value.size(), rhs.limbs,
+                rhs.limb_count, result.value.data());
+    trim_limbs(result.value);
+    result.is_positive = result.is_positive || result.Is_Zero();
+    return result;
+  }
+
+  // operator overloads are public facades to the private functions as well as
+  // it's capabilites of what each function operations were designed to do
+  // The binary operators write the result straight into the returned object,
+  // and when either operand is a temporary (i.e. the "a + b" in "a + b + c")
+  // they reuse its buffer via the in-place compound operators instead of
+  // allocating yet another one
+  Large_Numbers operator+(const Large_Numbers &rhs) const & {
+    auto result = with_capacity(
+        *this, std::max(this->value.size(), rhs.value.size()) + 1);
+    result += rhs;
+    return result;
+  }
+  Large_Numbers operator+(const Large_Numbers &rhs) && {
+    *this += rhs;
+    return std::move(*this);
+  }
+  Large_Numbers operator+(Large_Numbers &&rhs) const & {
+    rhs += *this; // a + b = b + a
+    return std::move(rhs);
+  }
+  Large_Numbers operator+(Large_Numbers &&rhs) && {
+    *this += rhs;
+    return std::move(*this);
+  }
+  Large_Numbers operator-(const Large_Numbers &rhs) const & {
+    auto result = with_capacity(
+        *this, std::max(this->value.size(), rhs.value.size()) + 1);
+    result -= rhs;
+    return result;
+  }
+  Large_Numbers operator-(const Large_Numbers &rhs) && {
+    *this -= rhs;
+    return std::move(*this);
+  }
+  Large_Numbers operator-(Large_Numbers &&rhs) const & {
+    rhs -= *this; // a - b = -(b - a)
+    rhs.negate();
+    return std::move(rhs);
+  }
+  Large_Numbers operator-(Large_Numbers &&rhs) && {
+    *this -= rhs;
+    return std::move(*this);
+  }
+  Large_Numbers operator*(const Large_Numbers &rhs) const {
+    // if either is multiples of 10^9's (10^9, 10^18, ... 10^9n), then we'll
+    // just multiply the non-zero parts and shift the limbs to the left, or
+    // more to the point, leave 0 limbs at the head of the product
+    auto lhs_zeros = trailing_zero_limbs(this->value);
+    auto rhs_zeros = trailing_zero_limbs(rhs.value);
+    auto result = Large_Numbers(
+        int_revvec_t(this->value.size() + rhs.value.size(), 0),
+        this->is_positive == rhs.is_positive);
+    op_multiply(this->value.data() + lhs_zeros,
+                this->value.size() - lhs_zeros,
+                rhs.value.data() + rhs_zeros, rhs.value.size() - rhs_zeros,
+                result.value.data() + lhs_zeros + rhs_zeros);
+    trim_limbs(result.value);
+    result.is_positive = result.is_positive || result.Is_Zero();
+    return result;
+  }
+  Large_Numbers operator/(const Large_Numbers &rhs) const {
+    return std::get<0>(divmod(rhs));
+  }
+  // only reason why we have modulo is because we have division and it's too
+  // useful if paired with division
+  Large_Numbers operator%(const Large_Numbers &rhs) const {
+    return std::get<1>(divmod(rhs));
+  }
+
+  // compound assignment operators work IN-PLACE on this->value, growing it
+  // only when the result gets wider (so the capacity gets reused across an
+  // accumulation loop) instead of building a new object like the binary
+  // operators above do
+  Large_Numbers &operator+=(const Large_Numbers &rhs) {
+    if (&rhs == this) {
+      // a += a; resizing value would pull the rug under rhs.value
+      return *this *= std::int64_t(2);
+    }
+    add_in_place(rhs.value.data(), rhs.value.size(), rhs.is_positive);
+    return *this;
+  }
+  Large_Numbers &operator+=(const std::int64_t &rhs) {
+    limb_t limbs[3];
+    auto size = i64_to_limbs(rhs, limbs);
+    add_in_place(limbs, size, rhs >= 0);
+    return *this;
+  }
+  Large_Numbers &operator-=(const Large_Numbers &rhs) {
+    if (&rhs == this) {
+      // a -= a
+      this->value.resize(1);
+      this->value[0] = 0;
+      this->is_positive = true;
+      return *this;
+    }
+    add_in_place(rhs.value.data(), rhs.value.size(), !rhs.is_positive);
+    return *this;
+  }
+  Large_Numbers &operator-=(const std::int64_t &rhs) {
+    limb_t limbs[3];
+    auto size = i64_to_limbs(rhs, limbs);
+    add_in_place(limbs, size, rhs < 0);
+    return *this;
+  }
+  Large_Numbers &operator*=(const Large_Numbers &rhs) {
+    multiply_in_place(rhs.value.data(), rhs.value.size(), rhs.is_positive);
+    return *this;
+  }
+  Large_Numbers &operator*=(const std::int64_t &rhs) {
+    auto magnitude = rhs >= 0 ? static_cast<std::uint64_t>(rhs)
+                              : 0 - static_cast<std::uint64_t>(rhs);
+    if (magnitude >= LIMB_BASE) {
+      return *this *= Large_Numbers(rhs);
+    }
+    // single limb: multiply in-place (each limb is read before written)
+    auto size = this->value.size();
+    this->value.push_back(0);
+    op_multiply_limb(this->value.data(), size, (limb_t)magnitude,
+                     this->value.data());
+    trim_limbs(this->value);
+    this->is_positive = (this->is_positive == (rhs >= 0)) || this->Is_Zero();
+    return *this;
+  }
+  Large_Numbers &operator/=(const Large_Numbers &rhs) {
+    auto result_is_positive = this->is_positive == rhs.is_positive;
+    if (rhs.value.size() == 1) {
+      // divide by single limb in-place
+      auto divisor = rhs.value[0];
+      if (divisor == 0) {
+        throw std::invalid_argument("Division by zero");
+      }
+      op_divide_limb(this->value.data(), this->value.size(), divisor);
+      trim_limbs(this->value);
+    } else {
+      auto result = op_divide(this->value, rhs.value);
+      this->value.swap(std::get<0>(result));
+    }
+    this->is_positive = result_is_positive || this->Is_Zero();
+    return *this;
+  }
+  Large_Numbers &operator%=(const Large_Numbers &rhs) {
+    if (rhs.value.size() == 1) {
+      // remainder of single limb in-place (quotient is never materialized)
+      auto divisor = rhs.value[0];
+      if (divisor == 0) {
+        throw std::invalid_argument("Division by zero");
+      }
+      auto remainder =
+          op_modulo_limb(this->value.data(), this->value.size(), divisor);
+      this->value.resize(1);
+      this->value[0] = remainder;
+    } else {
+      auto result = op_divide(this->value, rhs.value);
+      this->value.swap(std::get<1>(result));
+    }
+    // remainder keeps the sign of the dividend
+    this->is_positive = this->is_positive || this->Is_Zero();
+    return *this;
+  }
+
+  // unary operators (-0 stays +0)
+  Large_Numbers operator-() const & {
+    auto result = *this;
+    result.negate();
+    return result;
+  }
+  Large_Numbers operator-() && {
+    this->negate();
+    return std::move(*this);
+  }
+
+  // comparison operators
+  // three-way compare (-1 if *this < rhs, 0 if equal, 1 if *this > rhs):
+  // sign first, then (via op_compare()) the limb count, and only when both
+  // are the same the limbs from the most significant one down; no copies
+  int compare(const Large_Numbers &rhs) const {
+    auto lhs_is_positive = this->Is_Positive();
+    if (lhs_is_positive != rhs.Is_Positive()) {
+      return lhs_is_positive ? 1 : -1;
+    }
+    auto magnitude = op_compare(this->value.data(), this->value.size(),
+                                rhs.value.data(), rhs.value.size());
+    // the larger magnitude is the smaller number when both are negative
+    return lhs_is_positive ? magnitude : -magnitude;
+  }
+  // <, >, <= and >= are all rewritten by the compiler in terms of <=>, as is
+  // != in terms of ==
+  std::strong_ordering operator<=>(const Large_Numbers &rhs) const {
+    return compare(rhs) <=> 0;
+  }
+  bool operator==(const Large_Numbers &rhs) const {
+    return this->Is_Positive() == rhs.Is_Positive() &&
+           op_equal(this->value, rhs.value);
+  }
+
+  // conversion operators: to const string
+  operator std::string() const { return to_string_with_padding(); }
+  std::string to_string() const { return to_string_with_padding(); }
+  std::string to_string_with_padding(int width = 0,
+                                     char padding_char = '0') const {
+    // NOTE: we do not waste time trimming in case it was padded with zeros
+    // intentionally especially when converting to string, ideally we'd like to
+    // see it aligned Note that padding_char are ignored if width is 0
+    // the exact length is known up front, so the digits are written straight
+    // into the string's own buffer
+    auto str = std::string(to_chars_length(width), '\0');
+    to_chars(str.data(), str.data() + str.size(), width, padding_char);
+    return str;
+  }
+
+  // number of chars to_chars() writes: the sign (if negative) plus the
+  // digits, which are padded on the left up to width (the sign not included)
+  std::size_t to_chars_length(int width = 0) const {
+    auto digits = this->Size();
+    auto padded = width > 0 ? std::max(digits, static_cast<std::size_t>(width))
+                            : digits;
+    return (this->Is_Positive() ? 0 : 1) + padded;
+  }
+  // Writes the number into [first, last) in the spirit of std::to_chars():
+  // on success ptr is one past the last char written (no '\0' is added), if
+  // the buffer is shorter than to_chars_length(width), ec is
+  // std::errc::value_too_large, ptr is last and the buffer content is
+  // unspecified.  No intermediate strings: each limb is written in place
+  // NOTE: since the limb base is a power of 10, there is no radix conversion
+  // to speak of (which would have needed divide-and-conquer to be
+  // subquadratic if limbs were binary), every limb is simply 9 digits
+  std::to_chars_result to_chars(char *first, char *last, int width = 0,
+                                char padding_char = '0') const {
+    auto length = to_chars_length(width);
+    if (static_cast<std::size_t>(last - first) < length) {
+      return {last, std::errc::value_too_large};
+    }
+    if (!this->Is_Positive()) {
+      *first++ = '-';
+    }
+    auto padding = length - (this->Is_Positive() ? 0 : 1) - this->Size();
+    first = std::fill_n(first, padding, padding_char);
+    // most significant limb is NOT zero-padded, the rest are padded to 9
+    // digits (i.e. {5, 1234} is "1234000000005")
+    first = std::to_chars(first, last, this->value.back()).ptr;
+    for (auto limb = this->value.rbegin() + 1; limb != this->value.rend();
+         limb++) {
+      write_padded_limb(first, *limb);
+      first += LIMB_DIGITS;
+    }
+    return {first, std::errc()};
+  }
+
+  // Parses text in a single pass, in the spirit of std::from_chars(): an
+  // optional '-', then decimal digits which may be grouped with ',', '_', '\''
+  // or ' ' (i.e. "1,234,567"), and anything from a '.' on is truncated (i.e.
+  // 1234.567 -> 1234 truncated/rounded-down rather than rounded up).
+  // Parsing stops at the first character that does not fit, which ptr points
+  // at; ec is std::errc::invalid_argument if there were no digits at all, in
+  // which case result is left untouched.
+  // Digits are packed into limbs as they are read: every 9 digits from the
+  // front make a limb (most significant first), and at the end the limbs are
+  // reversed and scaled by the 10^r of the r (< 9) digits left over, which is
+  // one linear pass over the limbs.  Leading zeros are simply skipped.
+  // NOTE: since the limb base is a power of 10, this is already linear in the
+  // number of digits; there is no need for divide-and-conquer conversion
+  static std::from_chars_result from_chars(std::string_view text,
+                                           Large_Numbers &result) {
+    auto first = text.data();
+    auto last = first + text.size();
+    auto current = first;
+    auto is_negative = current != last && *current == '-';
+    if (is_negative) {
+      current++;
+    }
+    auto limbs = int_revvec_t();
+    limbs.reserve(text.size() / LIMB_DIGITS + 1);
+    limb_t group = 0;
+    std::size_t group_digits = 0;
+    auto seen_digit = false;
+    for (; current != last; current++) {
+      auto c = *current;
+      if (c >= '0' && c <= '9') {
+        seen_digit = true;
+        if (group == 0 && group_digits == 0 && limbs.empty() && c == '0') {
+          continue; // leading zero
+        }
+        group = group * 10 + static_cast<limb_t>(c - '0');
+        if (++group_digits == LIMB_DIGITS) {
+          limbs.push_back(group);
+          group = 0;
+          group_digits = 0;
+        }
+      } else if (c != ',' && c != '_' && c != '\'' && c != ' ') {
+        break;
+      }
+    }
+    if (current != last && *current == '.') {
+      for (current++; current != last && *current >= '0' && *current <= '9';
+           current++) {
+      }
+    }
+    if (!seen_digit) {
+      return {first, std::errc::invalid_argument};
+    }
+
+    // limbs now are the full groups, most significant first
+    std::reverse(limbs.begin(), limbs.end());
+    if (group_digits > 0) {
+      // value = limbs * 10^group_digits + group
+      double_limb_t scale = 1;
+      for (std::size_t i = 0; i < group_digits; i++) {
+        scale *= 10;
+      }
+      double_limb_t carry = group;
+      for (auto &limb : limbs) {
+        auto scaled = limb * scale + carry;
+        limb = static_cast<limb_t>(scaled % LIMB_BASE);
+        carry = scaled / LIMB_BASE;
+      }
+      if (carry != 0) {
+        limbs.push_back(static_cast<limb_t>(carry));
+      }
+    }
+    if (limbs.empty()) {
+      limbs.push_back(0); // all zeros (i.e. "0000") is just zero
+    }
+    result.value = std::move(limbs);
+    // zero has no sign
+    result.is_positive = !is_negative || result.Is_Zero();
+    return {current, std::errc()};
+  }
+
+  // throwing version of from_chars(), the whole string must be a number
+  Large_Numbers from_string(std::string_view str) {
+    if (str.size() == 0) {
+      throw std::invalid_argument("Empty string");
+    }
+    auto ret_large_number = Large_Numbers();
+    auto [ptr, ec] = from_chars(str, ret_large_number);
+    if (ec != std::errc() || ptr != str.data() + str.size()) {
+      throw std::invalid_argument(
+          "Invalid character '" + std::string(1, *ptr) + "' at position " +
+          std::to_string(ptr - str.data()) + " in string");
+    }
+    return ret_large_number;
+  }
+
+  // all functions which does not deal with "this" object are private
+  // but at the same time, they should be well modularized so that one can
+  // just copy-and-paste each needed functions to other C++ projects (mainly
+  // online puzzles and competitions)
+private:
+  static void store_little_endian(unsigned char *bytes, std::uint64_t v,
+                                  std::size_t size) {
+    for (std::size_t i = 0; i < size; i++) {
+      bytes[i] = static_cast<unsigned char>(v >> (8 * i));
+    }
+  }
+  static std::uint64_t load_little_endian(const unsigned char *bytes,
+                                          std::size_t size) {
+    std::uint64_t v = 0;
+    for (std::size_t i = size; i > 0; i--) {
+      v = (v << 8) | bytes[i - 1];
+    }
+    return v;
+  }
+  static void encode_serial_header(unsigned char *header, bool is_positive,
+                                   std::uint64_t limb_count) {
+    std::memcpy(header, "LNUM", 4);
+    store_little_endian(header + 4, SERIAL_VERSION, 2);
+    store_little_endian(header + 6, is_positive ? 0 : 1, 2);
+    store_little_endian(header + 8, limb_count, 8);
+  }
+  // {is_positive, limb count}
+  static std::tuple<bool, std::uint64_t>
+  decode_serial_header(const unsigned char *header) {
+    if (std::memcmp(header, "LNUM", 4) != 0) {
+      throw std::invalid_argument("Not a serialized number");
+    }
+    if (load_little_endian(header + 4, 2) != SERIAL_VERSION) {
+      throw std::invalid_argument("Unsupported serialization version");
+    }
+    auto flags = load_little_endian(header + 6, 2);
+    auto limb_count = load_little_endian(header + 8, 8);
+    if ((flags & ~std::uint64_t(1)) != 0 || limb_count == 0 ||
+        limb_count > std::numeric_limits<std::size_t>::max() / sizeof(limb_t)) {
+      throw std::invalid_argument("Corrupted serialized number");
+    }
+    return {(flags & 1) == 0, limb_count};
+  }
+  // no leading zero limbs (other than zero itself)
+  static void check_canonical(const limb_t *limbs, std::size_t limb_count) {
+    if (limb_count > 1 && limbs[limb_count - 1] == 0) {
+      throw std::invalid_argument("Serialized number has leading zero limbs");
+    }
+  }
+
+  // writes the limb as exactly 9 digits (i.e. 1234 -> "000001234") into
+  // buffer[0, 9), two digits at a time; every limb except the most
+  // significant one needs this padding when rendering
+  static void write_padded_limb(char *buffer, limb_t limb) {
+    static constexpr char digit_pairs[] =
+        "00010203040506070809101112131415161718192021222324252627282930313233"
+        "34353637383940414243444546474849505152535455565758596061626364656667"
+        "6869707172737475767778798081828384858687888990919293949596979899";
+    for (auto i = LIMB_DIGITS - 1; i > 0; i -= 2) {
+      auto pair = &digit_pairs[(limb % 100) * 2];
+      buffer[i] = pair[1];
+      buffer[i - 1] = pair[0];
+      limb /= 100;
+    }
+    buffer[0] = static_cast<char>('0' + limb);
+  }
+
+  // Hands the digits (no sign) to write(const char *, std::size_t) in chunks
+  // of a few KB, formatted straight from the limbs through a stack buffer
+  template <typename Writer>
+  static void write_limbs(const int_revvec_t &limbs, Writer &&write) {
+    // internal representation order of a number "1234567890123" is stored as
+    // {567890123, 1234} hence, iteration should be in reverse order, and all
+    // but the most significant limb needs to be zero-padded to 9 digits
+    char buffer[4096];
+    auto used = static_cast<std::size_t>(
+        std::to_chars(buffer, buffer + sizeof(buffer), limbs.back()).ptr -
+        buffer);
+    for (auto limb = limbs.rbegin() + 1; limb != limbs.rend(); limb++) {
+      if (used + LIMB_DIGITS > sizeof(buffer)) {
+        write(buffer, used);
+        used = 0;
+      }
+      write_padded_limb(buffer + used, *limb);
+      used += LIMB_DIGITS;
+    }
+    write(buffer, used);
+  }
+
+  // note: Only dumps digits, no sign
+  static void dump_digits(const int_revvec_t &digits,
+                          std::ostream &os = std::clog) {
+    write_limbs(digits, [&os](const char *chunk, std::size_t size) {
+      os.write(chunk, size);
+    });
+  }
+  // dumps digits with sign
+  static void dump_digits(const std::tuple<bool, int_revvec_t> &tup_digits) {
+    std::clog << (get<0>(tup_digits) ? " " : "-");
+    dump_digits(get<1>(tup_digits));
+  }
+  static void dump_digits(const Large_Numbers &ln,
+                          std::ostream &os = std::clog) {
+    os << (ln.is_positive ? " " : "-");
+    dump_digits(ln.value, os);
+  }
+
+  static int_revvec_t u64_to_limbs(std::uint64_t magnitude) {
+    // push_back appends to the end of the vector, hence if the sequence of the
+    // u64 is "1234567890123" in which we'd mod% it by 10^9, we'd get 567890123,
+    // then we would push_back it, then we'd divide by 10^9, and get 1234, and
+    // so on and push_back to the vector the final order on the vector will be
+    // {567890123, 1234} which conviniently is the reverse order we'd expect!
+    auto digits = int_revvec_t();
+    do {
+      digits.push_back(static_cast<limb_t>(magnitude % LIMB_BASE));
+      magnitude /= LIMB_BASE;
+    } while (magnitude > 0);
+    return digits;
+  }
+  std::tuple<bool, int_revvec_t> i64_to_digits(const std::int64_t &num64) {
+    auto is_positive = num64 >= 0;
+    // negate in unsigned so that INT64_MIN does not overflow
+    auto magnitude = is_positive ? static_cast<std::uint64_t>(num64)
+                                 : 0 - static_cast<std::uint64_t>(num64);
+    return std::tuple(is_positive, u64_to_limbs(magnitude));
+  }
+  std::tuple<bool, int_revvec_t> u64_to_digits(const std::uint64_t &num64) {
+    return std::tuple(true, u64_to_limbs(num64));
+  }
+
+  // if the digits is "0000123" (maybe for alignment purposes), we'll trim the
+  // front zeros so that it's "123".  Because internally, limbs are stored
+  // in reverse order ("000123" is stored as {123, 0}), we'll just
+  // pop off the back zeroes (but always leave at least one limb for zero)
+  int_revvec_t trim(const int_revvec_t &digits) {
+    // while the first limb is 0, pop it off (i.e. 000123 -> 123)
+    auto digits_cloned = digits;
+    while (digits_cloned.size() > 1 && digits_cloned.back() == 0) {
+      digits_cloned.pop_back();
+    }
+    return digits_cloned;
+  }
+  void trim() { value = trim(value); }
+
+  // count of 0 limbs at the least significant end (i.e. 25 * 10^18 has 2),
+  // which means the number is a multiple of 10^(9n) and multiplying by it
+  // is just a shift of whole limbs; zero itself has none
+  static std::size_t trailing_zero_limbs(const int_revvec_t &number_seq) {
+    std::size_t num_zeros = 0;
+    while (num_zeros < number_seq.size() && number_seq[num_zeros] == 0) {
+      num_zeros++;
+    }
+    return num_zeros == number_seq.size() ? 0 : num_zeros;
+  }
+
+  // We need comparitors for the vector<uint32_t> (magnitudes, both trimmed)
+  static bool op_equal(const int_revvec_t &lhs, const int_revvec_t &rhs) {
+    return lhs.size() == rhs.size() &&
+           op_compare(lhs.data(), lhs.size(), rhs.data(), rhs.size()) == 0;
+  }
+  static bool op_less_than(const int_revvec_t &lhs, const int_revvec_t &rhs) {
+    // NOTE: std::vector's operator< compares lexicographically from index 0,
+    // which is the LEAST significant limb, so it cannot be used for magnitude
+    return op_compare(lhs.data(), lhs.size(), rhs.data(), rhs.size()) < 0;
+  }
+  // multiplication engine: unlike the other op_* functions, these work on
+  // raw (pointer, size) pairs of limbs so that Karatsuba and Toom-3 can
+  // recurse on sub-ranges (halves/thirds) of the operands without cloning
+  // them; all of them deal with magnitudes only (sign is the caller's job)
+  static int_revvec_t op_multiply(const int_revvec_t &lhs,
+                                  const int_revvec_t &rhs) {
+    auto result = int_revvec_t(lhs.size() + rhs.size(), 0);
+    op_multiply(lhs.data(), lhs.size(), rhs.data(), rhs.size(), result.data());
+    while (result.size() > 1 && result.back() == 0) {
+      result.pop_back();
+    }
+    return result;
+  }
+
+  // number of limbs once the (most significant) zero limbs are ignored; zero
+  // is 0 limbs here, which is handy for the sub-ranges which can be all 0's
+  static std::size_t significant_size(const limb_t *limbs, std::size_t size) {
+    while (size > 0 && limbs[size - 1] == 0) {
+      size--;
+    }
+    return size;
+  }
+
+  // result must have room for lhs_size + rhs_size limbs; picks the algorithm
+  // based on the size of the shorter operand (see Multiply_Thresholds)
+  static void op_multiply(const limb_t *lhs, std::size_t lhs_size,
+                          const limb_t *rhs, std::size_t rhs_size,
+                          limb_t *result) {
+    if (lhs == rhs && lhs_size == rhs_size) {
+      op_square(lhs, lhs_size, result); // x * x, i.e. x *= x or pow()
+      return;
+    }
+    auto result_size = lhs_size + rhs_size;
+    lhs_size = significant_size(lhs, lhs_size);
+    rhs_size = significant_size(rhs, rhs_size);
+    if (lhs_size < rhs_size) {
+      std::swap(lhs, rhs);
+      std::swap(lhs_size, rhs_size);
+    }
+    // from here on, lhs is always the wider (or same width) operand
+    std::fill(result + lhs_size + rhs_size, result + result_size, 0);
+    if (rhs_size == 0) {
+      std::fill(result, result + lhs_size, 0); // x * 0 = 0
+    } else if (rhs_size == 1) {
+      op_multiply_limb(lhs, lhs_size, rhs[0], result);
+    } else if (rhs_size < Multiply_Thresholds::karatsuba) {
+      op_multiply_schoolbook(lhs, lhs_size, rhs, rhs_size, result);
+    } else if (rhs_size >= Multiply_Thresholds::ntt &&
+               lhs_size + rhs_size <= NTT_MAX_SIZE) {
+      op_multiply_ntt(lhs, lhs_size, rhs, rhs_size, result);
+    } else if (rhs_size * 2 <= lhs_size) {
+      op_multiply_unbalanced(lhs, lhs_size, rhs, rhs_size, result);
+    } else if (rhs_size < Multiply_Thresholds::toom3) {
+      op_multiply_karatsuba(lhs, lhs_size, rhs, rhs_size, result);
+    } else {
+      op_multiply_toom3(lhs, lhs_size, rhs, rhs_size, result);
+    }
+  }
+
+  // fast path for single limb (i.e. n * 7 or n * 123456789); result must have
+  // room for lhs_size + 1 limbs
+  static void op_multiply_limb(const limb_t *lhs, std::size_t lhs_size,
+                               limb_t rhs, limb_t *result) {
+    double_limb_t carry = 0;
+    for (std::size_t i = 0; i < lhs_size; i++) {
+      double_limb_t product = (double_limb_t)lhs[i] * rhs + carry;
+      carry = product / LIMB_BASE;
+      result[i] = (limb_t)(product - carry * LIMB_BASE);
     }
+    result[lhs_size] = (limb_t)carry;
+  }
 
-    // if lhs < 0, rhs < 0, make rhs positive, swap, and subtract
-    else if (!std::get<0>(left) && !std::get<0>(right)) {
-      // std::cout << "\tboth negative..." << std::endl;
-      auto result = op_subtract(std::get<1>(right), std::get<1>(left));
-      // if rhs >= lhs, then result is positive, else negative
-      return {op_less_than(std::get<1>(right), std::get<1>(left)), result};
+  // elementary school long multiplication; each partial product is at most
+  // (10^9 - 1)^2 + 2 * (10^9 - 1) < 2^64 so it never overflows double_limb_t
+  static void op_multiply_schoolbook(const limb_t *lhs, std::size_t lhs_size,
+                                     const limb_t *rhs, std::size_t rhs_size,
+                                     limb_t *result) {
+    std::fill(result, result + lhs_size + rhs_size, 0);
+    for (std::size_t j = 0; j < rhs_size; j++) {
+      if (rhs[j] == 0) {
+        continue;
+      }
+      double_limb_t carry = 0;
+      for (std::size_t i = 0; i < lhs_size; i++) {
+        double_limb_t product =
+            (double_limb_t)lhs[i] * rhs[j] + result[i + j] + carry;
+        carry = product / LIMB_BASE;
+        result[i + j] = (limb_t)(product - carry * LIMB_BASE);
+      }
+      result[j + lhs_size] = (limb_t)carry;
     }
+  }
 
-    // else some unknown state?
-    std::clog << "Unknown state: " << std::get<0>(left) << " and "
-              << std::get<0>(right) << std::endl;
-    throw std::invalid_argument("Unknown state");
+  // result must have room for 2 * size limbs; same dispatch as op_multiply()
+  // but with squaring variants where there is one, which skip the work a
+  // general multiplication spends on computing symmetric products twice
+  static void op_square(const limb_t *limbs, std::size_t size,
+                        limb_t *result) {
+    auto result_size = 2 * size;
+    size = significant_size(limbs, size);
+    std::fill(result + 2 * size, result + result_size, 0);
+    if (size == 0) {
+      return;
+    } else if (size == 1) {
+      op_multiply_limb(limbs, size, limbs[0], result);
+    } else if (size < Multiply_Thresholds::karatsuba) {
+      op_square_schoolbook(limbs, size, result);
+    } else if (size >= Multiply_Thresholds::ntt &&
+               2 * size <= NTT_MAX_SIZE) {
+      op_multiply_ntt(limbs, size, limbs, size, result);
+    } else if (size < Multiply_Thresholds::toom3) {
+      op_square_karatsuba(limbs, size, result);
+    } else {
+      op_multiply_toom3(limbs, size, limbs, size, result);
+    }
+  }
+  // every cross product a[i] * a[j] (i != j) shows up twice in a^2, so we
+  // only compute the ones above the diagonal, double them and add the
+  // diagonal a[i]^2 in, about half the limb products of the schoolbook
+  static void op_square_schoolbook(const limb_t *limbs, std::size_t size,
+                                   limb_t *result) {
+    std::fill(result, result + 2 * size, 0);
+    for (std::size_t i = 0; i + 1 < size; i++) {
+      if (limbs[i] == 0) {
+        continue;
+      }
+      double_limb_t carry = 0;
+      for (std::size_t j = i + 1; j < size; j++) {
+        double_limb_t product =
+            (double_limb_t)limbs[i] * limbs[j] + result[i + j] + carry;
+        carry = product / LIMB_BASE;
+        result[i + j] = (limb_t)(product - carry * LIMB_BASE);
+      }
+      result[i + size] = (limb_t)carry;
+    }
+    // result = 2 * result + diagonal, two limbs (a[i]^2 < B^2) at a time
+    double_limb_t carry = 0;
+    for (std::size_t i = 0; i < size; i++) {
+      double_limb_t square = (double_limb_t)limbs[i] * limbs[i];
+      double_limb_t low =
+          2 * (double_limb_t)result[2 * i] + square % LIMB_BASE + carry;
+      carry = low / LIMB_BASE;
+      result[2 * i] = (limb_t)(low - carry * LIMB_BASE);
+      double_limb_t high =
+          2 * (double_limb_t)result[2 * i + 1] + square / LIMB_BASE + carry;
+      carry = high / LIMB_BASE;
+      result[2 * i + 1] = (limb_t)(high - carry * LIMB_BASE);
+    }
+    assert(carry == 0);
   }
 
-  // operator subtract (to calculate n-1 and n-2)
-  std::tuple<bool /*is_positive*/, int_revvec_t /*digits*/> op_subtract_tuple(
-      std::tuple<bool /*is_positive*/, int_revvec_t /*digits*/> left,
-      std::tuple<bool /*is_positive*/, int_revvec_t /*digits*/> right) const {
-    // std::cout << "op_subtract_tuple:" << std::endl;
-    // std::cout << "\tleft (is_positive=" << std::get<0>(left) << ")  :";
-    // dump_digits(left);
-    // std::cout << std::endl;
-    // std::cout << "\tright (is_positive=" << std::get<0>(right) << ") :";
-    // dump_digits(right);
-    // std::cout << std::endl;
+  // set by multiply()/Fibonacci() with a Parallel, for this thread (and the
+  // tasks it hands out) only
+  static inline thread_local const Parallel *parallel_context = nullptr;
+  class Parallel_Scope {
+  public:
+    explicit Parallel_Scope(const Parallel &parallel)
+        : parallel(parallel), previous(parallel_context) {
+      if (this->parallel.pool == nullptr) {
+        this->parallel.pool = &Thread_Pool::Default();
+      }
+      parallel_context = &this->parallel;
+    }
+    ~Parallel_Scope() { parallel_context = previous; }
+    Parallel_Scope(const Parallel_Scope &) = delete;
+    Parallel_Scope &operator=(const Parallel_Scope &) = delete;
 
-    // first, clone so that we can reverse it
-    auto left_clone = std::get<1>(left);
-    auto right_clone = std::get<1>(right);
-    auto left_is_positive = std::get<0>(left);
-    auto right_is_positive = std::get<0>(right);
-    auto result_is_positive = op_less_than_tup(left, right) ? false : true;
+  private:
+    Parallel parallel;
+    const Parallel *previous;
+  };
+  // runs the independent tasks: one after another on this thread, unless
+  // there is a Parallel in effect, size (limbs) reaches its grain and its
+  // pool has more than one worker, in which case they are forked onto its
+  // pool and joined
+  template <typename... Tasks>
+  static void op_invoke(std::size_t size, Tasks &&...tasks) {
+    auto context = parallel_context;
+    if (context == nullptr || size < context->grain ||
+        context->pool->Size() <= 1) {
+      (tasks(), ...);
+      return;
+    }
+    auto group = Task_Group(*context->pool);
+    (group.Run([context, &tasks]() {
+      // the worker inherits the Parallel so nested products fork too
+      struct Restore {
+        const Parallel *previous;
+        ~Restore() { parallel_context = previous; }
+      } restore{parallel_context};
+      parallel_context = context;
+      tasks();
+    }),
+     ...);
+    group.Wait();
+  }
 
-    // now we can subtract (paying attention to assumptions that
-    // width/size/length of n.size() != m.size()) but also realizing that n - m
-    // != m - n
-    auto max_width = std::max(left_clone.size(), right_clone.size());
-    auto result = int_revvec_t();
-    // n - m = -m + n
-    // 123 - 87654 = -87654 + 123 = -87531
-    // 87654
-    // - 123
-    // =====
-    //  4 - 3 = 1
-    //  5 - 2 = 3
-    //  6 - 1 = 5
-    //  7 - 0 = 7
-    //  8 - 0 = 8
-    // sign it => -87531
-    // very trivial elementary school math, but doing this in code makes it seem
-    // complex :P
-    // * (+l) - (+r) = subtract (l-r) or (r-l) and if r > l, negate;
-    //   i.e. 10 - 5 = 5; 5 - 10 = -5
-    // * (+l) - (-r) = (+l) + (+r) = just addition;
-    //   i.e. 10 - -5 = 10 + 5 = 15; 5 - -10 = 5 + 10 = 15
-    // * (-l) - (+r) = just add and negate;
-    //   i.e. -10 - 5 = -10 + -5 = -15; -5 - 10 = -5 + -10 = -15
-    // * (-l) - (-r) = (-l) + (+r) = subtract (r-l) or (l-r) and if r > l,
-    // negate
-    //  i.e. -10 - -5 = -10 + 5 = -5; -5 - -10 = -5 + 10 = 5
-
-    // * (+l) - (+r) = subtract (l-r) or (r-l) and if r > l, negate;
-    //   i.e. 10 - 5 = 5; 5 - 10 = -5
-    if (left_is_positive && right_is_positive) {
-      result_is_positive = true;
-      // if both are postive, first check if left < right, if so, swap and set
-      // (and later negate)
-      if (op_less_than(left_clone, right_clone)) {
-        // std::swap(left_clone, right_clone); // alternatively, just r - l
-        result_is_positive = false;
-        result = op_subtract(right_clone, left_clone); // swap left and right
-      } else {
-        result = op_subtract(left_clone, right_clone);
-      }
-    }
-    // * (+l) - (-r) = (+l) + (+r) = just addition;
-    //   i.e. 10 - -5 = 10 + 5 = 15; 5 - -10 = 5 + 10 = 15
-    else if (left_is_positive != right_is_positive) {
-      // if right is negative, then it's just addition (n - -m = n + m)
-      // if left is negative, swap, then add, and negate
-      result_is_positive = left_is_positive;    // negate if left is negative
-      result = op_add(left_clone, right_clone); // either way, just add...
-    }
-    // * (-l) - (+r) = just add and negate;
-    //   i.e. -10 - 5 = -10 + -5 = -15; -5 - 10 = -5 + -10 = -15
-    else if (!left_is_positive && right_is_positive) {
-      result_is_positive = false;
-      // if left is negative, then it's just addition (n - -m = n + m)
-      // if right is negative, swap, then add, and negate
-      result = op_add(left_clone, right_clone); // either way, just add...
-    }
-    // * (-l) - (-r) = (-l) + (+r) = subtract (r-l) or (l-r) and if r > l,
-    // negate
-    //  i.e. -10 - -5 = -10 + 5 = -5; -5 - -10 = -5 + 10 = 5
-    else if (!left_is_positive && !right_is_positive) {
-      result_is_positive = true;
-      // if both are negative, make right side positive and then
-      // test to see if m > n, and if so, just subtract (-n - -m = m - n)
-      // else, swap again, and then subtract and then negate (n - m)
-
-      // first, make right side positive (i.e. -left + right)
-      if (op_less_than(left_clone, right_clone)) {
-        // now that right side is positive, we can subtract right - left
-        // (basically, swapped) IF right > left
-        result = op_subtract(right_clone, left_clone);
+  // number of chunks the batch APIs cut count operations (width limbs in
+  // total) into: none/one to stay on this thread, else a few per worker
+  static std::size_t op_chunk_count(std::size_t count, std::size_t width,
+                                    const Parallel &parallel) {
+    auto &pool =
+        parallel.pool != nullptr ? *parallel.pool : Thread_Pool::Default();
+    if (width < parallel.grain || pool.Size() == 1) {
+      return std::min<std::size_t>(count, 1);
+    }
+    return std::min(count, pool.Size() * 4);
+  }
+  // runs body(chunk, begin, end) over chunks contiguous slices of [0, count),
+  // on the pool of parallel when there is more than one
+  template <typename Body>
+  static void op_for_chunks(std::size_t count, std::size_t chunks,
+                            const Parallel &parallel, const Body &body) {
+    if (chunks <= 1) {
+      if (count > 0) {
+        body(0, 0, count);
+      }
+      return;
+    }
+    auto group = Task_Group(
+        parallel.pool != nullptr ? *parallel.pool : Thread_Pool::Default());
+    for (std::size_t chunk = 0; chunk < chunks; chunk++) {
+      group.Run([&body, chunk, begin = count * chunk / chunks,
+                 end = count * (chunk + 1) / chunks]() {
+        body(chunk, begin, end);
+      });
+    }
+    group.Wait();
+  }
+
+  // when lhs is at least twice as wide as rhs, splitting both in halves would
+  // waste time multiplying zeros, so we slice lhs into rhs-sized chunks and
+  // do (balanced) chunk * rhs for each, adding them at the chunk offset
+  static void op_multiply_unbalanced(const limb_t *lhs, std::size_t lhs_size,
+                                     const limb_t *rhs, std::size_t rhs_size,
+                                     limb_t *result) {
+    auto result_size = lhs_size + rhs_size;
+    std::fill(result, result + result_size, 0);
+    auto chunk_product = int_revvec_t(rhs_size * 2);
+    for (std::size_t offset = 0; offset < lhs_size; offset += rhs_size) {
+      auto chunk_size = std::min(rhs_size, lhs_size - offset);
+      op_multiply(lhs + offset, chunk_size, rhs, rhs_size,
+                  chunk_product.data());
+      op_add_at(result + offset, result_size - offset, chunk_product.data(),
+                chunk_size + rhs_size);
+    }
+  }
+
+  // Bulk limb kernels, the loops that additions/subtractions (and hence
+  // Fibonacci iterations) spend their time in:
+  //    add_n:      out = lhs + rhs over size limbs, returns the carry out
+  //    subtract_n: out = lhs - rhs over size limbs, returns the borrow out
+  //    compare_n:  three-way compare of two size-limb magnitudes
+  // out may alias lhs or rhs.  The SIMD versions add/subtract a block of
+  // lanes at once and then resolve the carries of the whole block with
+  // scalar bit tricks on the lane masks: with G the lanes that carry out on
+  // their own (sum >= 10^9) and P the ones that only pass an incoming carry
+  // along (sum == 10^9 - 1), the lanes receiving a carry are
+  //    ((G << 1 | carry_in) + P) ^ P
+  // (the + ripples a carry up through a run of P lanes, just like binary
+  // addition) and the bit just above the last lane is the carry out.  The
+  // same works for borrows with G = (diff < 0) and P = (diff == 0).
+  // Sums stay below 2^31 so signed 32-bit compares are fine
+  struct Limb_Kernels {
+    const char *name;
+    limb_t (*add_n)(limb_t *out, const limb_t *lhs, const limb_t *rhs,
+                    std::size_t size);
+    limb_t (*subtract_n)(limb_t *out, const limb_t *lhs, const limb_t *rhs,
+                         std::size_t size);
+    int (*compare_n)(const limb_t *lhs, const limb_t *rhs, std::size_t size);
+  };
+
+  static limb_t op_add_n_scalar(limb_t *out, const limb_t *lhs,
+                                const limb_t *rhs, std::size_t size,
+                                limb_t carry = 0) {
+    for (std::size_t i = 0; i < size; i++) {
+      limb_t sum = lhs[i] + rhs[i] + carry;
+      carry = sum >= LIMB_BASE ? 1 : 0;
+      out[i] = sum - carry * LIMB_BASE;
+    }
+    return carry;
+  }
+  static limb_t op_subtract_n_scalar(limb_t *out, const limb_t *lhs,
+                                     const limb_t *rhs, std::size_t size,
+                                     limb_t borrow = 0) {
+    for (std::size_t i = 0; i < size; i++) {
+      limb_t subtrahend = rhs[i] + borrow;
+      borrow = lhs[i] < subtrahend ? 1 : 0;
+      out[i] = lhs[i] + borrow * LIMB_BASE - subtrahend;
+    }
+    return borrow;
+  }
+  static int op_compare_n_scalar(const limb_t *lhs, const limb_t *rhs,
+                                 std::size_t size) {
+    for (auto i = size; i > 0; i--) {
+      if (lhs[i - 1] != rhs[i - 1]) {
+        return lhs[i - 1] < rhs[i - 1] ? -1 : 1;
+      }
+    }
+    return 0;
+  }
+
+#ifdef LARGE_NUMBERS_HAS_X86_KERNELS
+  // SSE2 is part of x86-64, so these need no runtime check there
+  // lane i of carry_lanes_sse2[mask] is bit i of mask
+  static inline const __m128i *carry_lanes_sse2() {
+    alignas(16) static const limb_t lanes[16][4] = {
+        {0, 0, 0, 0}, {1, 0, 0, 0}, {0, 1, 0, 0}, {1, 1, 0, 0},
+        {0, 0, 1, 0}, {1, 0, 1, 0}, {0, 1, 1, 0}, {1, 1, 1, 0},
+        {0, 0, 0, 1}, {1, 0, 0, 1}, {0, 1, 0, 1}, {1, 1, 0, 1},
+        {0, 0, 1, 1}, {1, 0, 1, 1}, {0, 1, 1, 1}, {1, 1, 1, 1}};
+    return reinterpret_cast<const __m128i *>(lanes);
+  }
+  __attribute__((target("sse2"))) static limb_t
+  op_add_n_sse2(limb_t *out, const limb_t *lhs, const limb_t *rhs,
+                std::size_t size) {
+    const auto base = _mm_set1_epi32(LIMB_BASE);
+    const auto base_minus_1 = _mm_set1_epi32(LIMB_BASE - 1);
+    unsigned carry = 0;
+    std::size_t i = 0;
+    for (; i + 4 <= size; i += 4) {
+      auto sum = _mm_add_epi32(
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(lhs + i)),
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(rhs + i)));
+      unsigned generate = _mm_movemask_ps(
+          _mm_castsi128_ps(_mm_cmpgt_epi32(sum, base_minus_1)));
+      unsigned propagate = _mm_movemask_ps(
+          _mm_castsi128_ps(_mm_cmpeq_epi32(sum, base_minus_1)));
+      auto carries = (((generate << 1) | carry) + propagate) ^ propagate;
+      carry = (carries >> 4) & 1;
+      sum = _mm_add_epi32(sum, carry_lanes_sse2()[carries & 15]);
+      sum = _mm_sub_epi32(
+          sum, _mm_and_si128(_mm_cmpgt_epi32(sum, base_minus_1), base));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), sum);
+    }
+    return op_add_n_scalar(out + i, lhs + i, rhs + i, size - i, carry);
+  }
+  __attribute__((target("sse2"))) static limb_t
+  op_subtract_n_sse2(limb_t *out, const limb_t *lhs, const limb_t *rhs,
+                     std::size_t size) {
+    const auto base = _mm_set1_epi32(LIMB_BASE);
+    const auto zero = _mm_setzero_si128();
+    unsigned borrow = 0;
+    std::size_t i = 0;
+    for (; i + 4 <= size; i += 4) {
+      auto diff = _mm_sub_epi32(
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(lhs + i)),
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(rhs + i)));
+      unsigned generate =
+          _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(zero, diff)));
+      unsigned propagate =
+          _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(diff, zero)));
+      auto borrows = (((generate << 1) | borrow) + propagate) ^ propagate;
+      borrow = (borrows >> 4) & 1;
+      diff = _mm_sub_epi32(diff, carry_lanes_sse2()[borrows & 15]);
+      diff = _mm_add_epi32(diff,
+                           _mm_and_si128(_mm_cmpgt_epi32(zero, diff), base));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), diff);
+    }
+    return op_subtract_n_scalar(out + i, lhs + i, rhs + i, size - i, borrow);
+  }
+  __attribute__((target("sse2"))) static int
+  op_compare_n_sse2(const limb_t *lhs, const limb_t *rhs, std::size_t size) {
+    auto i = size;
+    for (; i >= 4; i -= 4) {
+      unsigned equal = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(lhs + i - 4)),
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(rhs + i - 4)))));
+      if (equal != 15) {
+        // most significant lane that differs
+        auto lane = i - 4 + std::bit_width(~equal & 15u) - 1;
+        return lhs[lane] < rhs[lane] ? -1 : 1;
+      }
+    }
+    return op_compare_n_scalar(lhs, rhs, i);
+  }
+
+  __attribute__((target("avx2"))) static limb_t
+  op_add_n_avx2(limb_t *out, const limb_t *lhs, const limb_t *rhs,
+                std::size_t size) {
+    const auto base = _mm256_set1_epi32(LIMB_BASE);
+    const auto base_minus_1 = _mm256_set1_epi32(LIMB_BASE - 1);
+    const auto lane_index = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const auto one = _mm256_set1_epi32(1);
+    unsigned carry = 0;
+    std::size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+      auto sum = _mm256_add_epi32(
+          _mm256_loadu_si256(reinterpret_cast<const __m256i *>(lhs + i)),
+          _mm256_loadu_si256(reinterpret_cast<const __m256i *>(rhs + i)));
+      unsigned generate = _mm256_movemask_ps(
+          _mm256_castsi256_ps(_mm256_cmpgt_epi32(sum, base_minus_1)));
+      unsigned propagate = _mm256_movemask_ps(
+          _mm256_castsi256_ps(_mm256_cmpeq_epi32(sum, base_minus_1)));
+      auto carries = (((generate << 1) | carry) + propagate) ^ propagate;
+      carry = (carries >> 8) & 1;
+      sum = _mm256_add_epi32(
+          sum, _mm256_and_si256(
+                   _mm256_srlv_epi32(_mm256_set1_epi32(carries), lane_index),
+                   one));
+      sum = _mm256_sub_epi32(
+          sum, _mm256_and_si256(_mm256_cmpgt_epi32(sum, base_minus_1), base));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), sum);
+    }
+    return op_add_n_scalar(out + i, lhs + i, rhs + i, size - i, carry);
+  }
+  __attribute__((target("avx2"))) static limb_t
+  op_subtract_n_avx2(limb_t *out, const limb_t *lhs, const limb_t *rhs,
+                     std::size_t size) {
+    const auto base = _mm256_set1_epi32(LIMB_BASE);
+    const auto zero = _mm256_setzero_si256();
+    const auto lane_index = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const auto one = _mm256_set1_epi32(1);
+    unsigned borrow = 0;
+    std::size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+      auto diff = _mm256_sub_epi32(
+          _mm256_loadu_si256(reinterpret_cast<const __m256i *>(lhs + i)),
+          _mm256_loadu_si256(reinterpret_cast<const __m256i *>(rhs + i)));
+      unsigned generate = _mm256_movemask_ps(
+          _mm256_castsi256_ps(_mm256_cmpgt_epi32(zero, diff)));
+      unsigned propagate = _mm256_movemask_ps(
+          _mm256_castsi256_ps(_mm256_cmpeq_epi32(diff, zero)));
+      auto borrows = (((generate << 1) | borrow) + propagate) ^ propagate;
+      borrow = (borrows >> 8) & 1;
+      diff = _mm256_sub_epi32(
+          diff, _mm256_and_si256(
+                    _mm256_srlv_epi32(_mm256_set1_epi32(borrows), lane_index),
+                    one));
+      diff = _mm256_add_epi32(
+          diff, _mm256_and_si256(_mm256_cmpgt_epi32(zero, diff), base));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), diff);
+    }
+    return op_subtract_n_scalar(out + i, lhs + i, rhs + i, size - i, borrow);
+  }
+  __attribute__((target("avx2"))) static int
+  op_compare_n_avx2(const limb_t *lhs, const limb_t *rhs, std::size_t size) {
+    auto i = size;
+    for (; i >= 8; i -= 8) {
+      unsigned equal = _mm256_movemask_ps(_mm256_castsi256_ps(
+          _mm256_cmpeq_epi32(
+              _mm256_loadu_si256(reinterpret_cast<const __m256i *>(lhs + i - 8)),
+              _mm256_loadu_si256(
+                  reinterpret_cast<const __m256i *>(rhs + i - 8)))));
+      if (equal != 255) {
+        auto lane = i - 8 + std::bit_width(~equal & 255u) - 1;
+        return lhs[lane] < rhs[lane] ? -1 : 1;
+      }
+    }
+    return op_compare_n_scalar(lhs, rhs, i);
+  }
+#endif // LARGE_NUMBERS_HAS_X86_KERNELS
+
+  // every kernel set this CPU can run, best first (the scalar one is last)
+  static std::vector<Limb_Kernels> available_limb_kernels() {
+    auto kernels = std::vector<Limb_Kernels>();
+#ifdef LARGE_NUMBERS_HAS_X86_KERNELS
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+      kernels.push_back({"avx2", op_add_n_avx2, op_subtract_n_avx2,
+                         op_compare_n_avx2});
+    }
+    if (__builtin_cpu_supports("sse2")) {
+      kernels.push_back({"sse2", op_add_n_sse2, op_subtract_n_sse2,
+                         op_compare_n_sse2});
+    }
+#endif
+    kernels.push_back(
+        {"scalar",
+         [](limb_t *out, const limb_t *lhs, const limb_t *rhs,
+            std::size_t size) { return op_add_n_scalar(out, lhs, rhs, size); },
+         [](limb_t *out, const limb_t *lhs, const limb_t *rhs,
+            std::size_t size) {
+           return op_subtract_n_scalar(out, lhs, rhs, size);
+         },
+         op_compare_n_scalar});
+    return kernels;
+  }
+  // chosen once, on first use
+  static const Limb_Kernels &limb_kernels() {
+    static const Limb_Kernels kernels = available_limb_kernels().front();
+    return kernels;
+  }
+  // below this many limbs the call through the kernel pointer is not worth it
+  static constexpr std::size_t LIMB_KERNEL_MIN_SIZE = 16;
+
+  // dst += src (in-place); dst must be wide enough to absorb the final carry
+  static void op_add_at(limb_t *dst, std::size_t dst_size, const limb_t *src,
+                        std::size_t src_size) {
+    src_size = significant_size(src, src_size);
+    auto carry = src_size >= LIMB_KERNEL_MIN_SIZE
+                     ? limb_kernels().add_n(dst, dst, src, src_size)
+                     : op_add_n_scalar(dst, dst, src, src_size);
+    std::size_t i = src_size;
+    for (; carry > 0 && i < dst_size; i++) {
+      limb_t sum = dst[i] + carry;
+      carry = sum >= LIMB_BASE ? 1 : 0;
+      dst[i] = sum - carry * LIMB_BASE;
+    }
+    assert(carry == 0);
+  }
+
+  // dst -= src (in-place); assumes dst >= src
+  static void op_subtract_at(limb_t *dst, std::size_t dst_size,
+                             const limb_t *src, std::size_t src_size) {
+    src_size = significant_size(src, src_size);
+    auto borrow = src_size >= LIMB_KERNEL_MIN_SIZE
+                      ? limb_kernels().subtract_n(dst, dst, src, src_size)
+                      : op_subtract_n_scalar(dst, dst, src, src_size);
+    std::size_t i = src_size;
+    for (; borrow > 0 && i < dst_size; i++) {
+      borrow = dst[i] == 0 ? 1 : 0;
+      dst[i] = dst[i] + borrow * LIMB_BASE - 1;
+    }
+    assert(borrow == 0);
+  }
+
+  // dst = src - dst (in-place); assumes src >= dst, and dst has room for
+  // src_size limbs (the result is as wide as src)
+  static void op_reverse_subtract_at(limb_t *dst, const limb_t *src,
+                                     std::size_t src_size) {
+    auto borrow = src_size >= LIMB_KERNEL_MIN_SIZE
+                      ? limb_kernels().subtract_n(dst, src, dst, src_size)
+                      : op_subtract_n_scalar(dst, src, dst, src_size);
+    assert(borrow == 0);
+  }
+
+  // *this *= rhs
+  void multiply_in_place(const limb_t *rhs, std::size_t rhs_size,
+                         bool rhs_is_positive) {
+    // the product is built in a per-thread scratch buffer and then swapped
+    // with value, so that the old buffer becomes the scratch for next time
+    // (swap() copies instead when value's resource is another one, e.g. an
+    // Arena that may go away before this thread does).  The scratch is moved
+    // out for the duration, since op_multiply() may fork and run stolen tasks
+    // that multiply in place on this thread too
+    static thread_local int_revvec_t scratch(std::pmr::get_default_resource());
+    auto product = std::move(scratch);
+    auto result_is_positive = this->is_positive == rhs_is_positive;
+    product.resize(this->value.size() + rhs_size);
+    op_multiply(this->value.data(), this->value.size(), rhs, rhs_size,
+                product.data());
+    this->value.swap(product);
+    scratch = std::move(product);
+    trim_limbs(this->value);
+    this->is_positive = result_is_positive || this->Is_Zero();
+  }
+  // signed this += rhs (rhs given as raw limbs so that the compound
+  // operators can pass in small numbers on the stack); same sign is a
+  // magnitude add, otherwise we subtract the narrower magnitude from the
+  // wider, in-place either way
+  void add_in_place(const limb_t *rhs, std::size_t rhs_size,
+                    bool rhs_is_positive) {
+    rhs_size = significant_size(rhs, rhs_size);
+    if (rhs_size == 0) {
+      return; // x + 0 = x
+    }
+    auto lhs_size = this->value.size();
+    if (this->Is_Zero()) {
+      this->is_positive = rhs_is_positive; // 0 + x takes the sign of x
+    }
+    if (this->is_positive == rhs_is_positive) {
+      // one more limb than the wider of the two to absorb the last carry
+      this->value.resize(std::max(lhs_size, rhs_size) + 1, 0);
+      op_add_at(this->value.data(), this->value.size(), rhs, rhs_size);
+    } else if (op_compare(this->value.data(), lhs_size, rhs, rhs_size) >= 0) {
+      // |lhs| >= |rhs|: lhs keeps its sign
+      op_subtract_at(this->value.data(), lhs_size, rhs, rhs_size);
+    } else {
+      // |lhs| < |rhs|: result is rhs - lhs with the sign of rhs
+      this->value.resize(rhs_size, 0);
+      op_reverse_subtract_at(this->value.data(), rhs, rhs_size);
+      this->is_positive = rhs_is_positive;
+    }
+    trim_limbs(this->value);
+    this->is_positive = this->is_positive || this->Is_Zero();
+  }
+
+  // int64_t as limbs on the caller's stack (at most 3 limbs), returns size
+  static std::size_t i64_to_limbs(const std::int64_t &num64, limb_t *limbs) {
+    auto magnitude = num64 >= 0 ? static_cast<std::uint64_t>(num64)
+                                : 0 - static_cast<std::uint64_t>(num64);
+    std::size_t size = 0;
+    do {
+      limbs[size++] = static_cast<limb_t>(magnitude % LIMB_BASE);
+      magnitude /= LIMB_BASE;
+    } while (magnitude > 0);
+    return size;
+  }
+
+  // Karatsuba: with a = a1 * B^m + a0 and b = b1 * B^m + b0,
+  //   a * b = z2 * B^2m + z1 * B^m + z0, where
+  //   z0 = a0 * b0, z2 = a1 * b1, z1 = (a0 + a1) * (b0 + b1) - z0 - z2
+  // which is 3 half-sized multiplications instead of 4
+  // assumes lhs_size >= rhs_size > lhs_size / 2 (see op_multiply())
+  static void op_multiply_karatsuba(const limb_t *lhs, std::size_t lhs_size,
+                                    const limb_t *rhs, std::size_t rhs_size,
+                                    limb_t *result) {
+    auto m = lhs_size / 2;
+    auto result_size = lhs_size + rhs_size;
+    auto lhs_sum = int_revvec_t(lhs_size - m + 1, 0);
+    std::copy(lhs + m, lhs + lhs_size, lhs_sum.begin());
+    op_add_at(lhs_sum.data(), lhs_sum.size(), lhs, m);
+    auto rhs_sum = int_revvec_t(std::max(m, rhs_size - m) + 1, 0);
+    std::copy(rhs + m, rhs + rhs_size, rhs_sum.begin());
+    op_add_at(rhs_sum.data(), rhs_sum.size(), rhs, m);
+    auto z1 = int_revvec_t(lhs_sum.size() + rhs_sum.size());
+
+    // z0 goes to result[0..2m) and z2 goes to result[2m..), they don't
+    // overlap so we can multiply straight into the result
+    op_invoke(
+        m, [&]() { op_multiply(lhs, m, rhs, m, result); },
+        [&]() {
+          op_multiply(lhs + m, lhs_size - m, rhs + m, rhs_size - m,
+                      result + 2 * m);
+        },
+        [&]() {
+          op_multiply(lhs_sum.data(), lhs_sum.size(), rhs_sum.data(),
+                      rhs_sum.size(), z1.data());
+        });
+    op_subtract_at(z1.data(), z1.size(), result, 2 * m);
+    op_subtract_at(z1.data(), z1.size(), result + 2 * m, result_size - 2 * m);
+    op_add_at(result + m, result_size - m, z1.data(), z1.size());
+  }
+  // Karatsuba for a^2: z0 = a0^2, z2 = a1^2, z1 = (a0 + a1)^2 - z0 - z2, so
+  // all 3 sub-products are squares again (and only one sum to build)
+  static void op_square_karatsuba(const limb_t *limbs, std::size_t size,
+                                  limb_t *result) {
+    auto m = size / 2;
+    auto result_size = 2 * size;
+    auto sum = int_revvec_t(size - m + 1, 0);
+    std::copy(limbs + m, limbs + size, sum.begin());
+    op_add_at(sum.data(), sum.size(), limbs, m);
+    auto z1 = int_revvec_t(2 * sum.size());
+    op_invoke(
+        m, [&]() { op_square(limbs, m, result); },
+        [&]() { op_square(limbs + m, size - m, result + 2 * m); },
+        [&]() { op_square(sum.data(), sum.size(), z1.data()); });
+    op_subtract_at(z1.data(), z1.size(), result, 2 * m);
+    op_subtract_at(z1.data(), z1.size(), result + 2 * m, result_size - 2 * m);
+    op_add_at(result + m, result_size - m, z1.data(), z1.size());
+  }
+
+  // Number-theoretic transform (NTT) multiplication: an FFT over Z/pZ instead
+  // of complex doubles, so the pointwise products are exact and there's no
+  // rounding error analysis to worry about.  A single 30-bit prime cannot hold
+  // a convolution coefficient (up to n * (10^9 - 1)^2), so we do the
+  // convolution modulo 3 primes (all of the form c * 2^k + 1 with primitive
+  // root 3) and recombine with CRT (Garner), which is exact as long as the
+  // coefficient < p0 * p1 * p2 (~7.9 * 10^25), which holds for the maximum
+  // transform size of 2^23 limbs (~75 million digits product)
+  static constexpr std::uint32_t NTT_PRIME_0 = 998244353; // 119 * 2^23 + 1
+  static constexpr std::uint32_t NTT_PRIME_1 = 167772161; // 5 * 2^25 + 1
+  static constexpr std::uint32_t NTT_PRIME_2 = 469762049; // 7 * 2^26 + 1
+  static constexpr std::uint32_t NTT_PRIMITIVE_ROOT = 3;
+  static constexpr std::size_t NTT_MAX_SIZE = std::size_t(1) << 23;
+
+  static constexpr std::uint32_t mod_pow(std::uint64_t base, std::uint64_t exp,
+                                         std::uint32_t mod) {
+    std::uint64_t result = 1;
+    base %= mod;
+    while (exp > 0) {
+      if (exp & 1) {
+        result = result * base % mod;
+      }
+      base = base * base % mod;
+      exp >>= 1;
+    }
+    return (std::uint32_t)result;
+  }
+
+  // in-place iterative (Cooley-Tukey, bit-reversed input) transform; MOD is a
+  // template parameter so that the compiler can turn "% MOD" into
+  // multiply-and-shift instead of an actual 64-bit division
+  template <std::uint32_t MOD>
+  static void ntt(std::vector<std::uint32_t> &values, bool inverse) {
+    auto n = values.size();
+    for (std::size_t i = 1, j = 0; i < n; i++) {
+      auto bit = n >> 1;
+      for (; j & bit; bit >>= 1) {
+        j ^= bit;
+      }
+      j ^= bit;
+      if (i < j) {
+        std::swap(values[i], values[j]);
+      }
+    }
+    auto roots = std::vector<std::uint32_t>(n / 2 + 1);
+    for (std::size_t length = 2; length <= n; length <<= 1) {
+      auto half = length / 2;
+      auto root = mod_pow(NTT_PRIMITIVE_ROOT, (MOD - 1) / length, MOD);
+      if (inverse) {
+        root = mod_pow(root, MOD - 2, MOD);
+      }
+      // precompute the twiddle factors of this stage so the butterflies below
+      // do not depend on each other (w *= root) and can be pipelined
+      roots[0] = 1;
+      for (std::size_t j = 1; j < half; j++) {
+        roots[j] = (std::uint32_t)((std::uint64_t)roots[j - 1] * root % MOD);
+      }
+      for (std::size_t i = 0; i < n; i += length) {
+        for (std::size_t j = 0; j < half; j++) {
+          auto u = values[i + j];
+          auto v =
+              (std::uint32_t)((std::uint64_t)values[i + j + half] * roots[j] %
+                              MOD);
+          values[i + j] = u + v >= MOD ? u + v - MOD : u + v;
+          values[i + j + half] = u >= v ? u - v : u + MOD - v;
+        }
+      }
+    }
+    if (inverse) {
+      std::uint64_t n_inverse = mod_pow(n, MOD - 2, MOD);
+      for (auto &value : values) {
+        value = (std::uint32_t)(value * n_inverse % MOD);
+      }
+    }
+  }
+
+  // cyclic convolution of lhs and rhs modulo MOD (transform size n); a
+  // square (lhs and rhs being the same limbs) needs one forward transform
+  template <std::uint32_t MOD>
+  static std::vector<std::uint32_t>
+  ntt_convolution(const limb_t *lhs, std::size_t lhs_size, const limb_t *rhs,
+                  std::size_t rhs_size, std::size_t n) {
+    auto lhs_values = std::vector<std::uint32_t>(n, 0);
+    for (std::size_t i = 0; i < lhs_size; i++) {
+      lhs_values[i] = lhs[i] % MOD;
+    }
+    ntt<MOD>(lhs_values, false);
+    if (lhs == rhs && lhs_size == rhs_size) {
+      for (auto &value : lhs_values) {
+        value = (std::uint32_t)((std::uint64_t)value * value % MOD);
+      }
+      ntt<MOD>(lhs_values, true);
+      return lhs_values;
+    }
+    auto rhs_values = std::vector<std::uint32_t>(n, 0);
+    for (std::size_t i = 0; i < rhs_size; i++) {
+      rhs_values[i] = rhs[i] % MOD;
+    }
+    ntt<MOD>(rhs_values, false);
+    for (std::size_t i = 0; i < n; i++) {
+      lhs_values[i] =
+          (std::uint32_t)((std::uint64_t)lhs_values[i] * rhs_values[i] % MOD);
+    }
+    ntt<MOD>(lhs_values, true);
+    return lhs_values;
+  }
+
+  // result must have room for lhs_size + rhs_size limbs, and
+  // lhs_size + rhs_size must be <= NTT_MAX_SIZE
+  static void op_multiply_ntt(const limb_t *lhs, std::size_t lhs_size,
+                              const limb_t *rhs, std::size_t rhs_size,
+                              limb_t *result) {
+    auto result_size = lhs_size + rhs_size;
+    std::size_t n = 1;
+    while (n < result_size - 1) {
+      n <<= 1;
+    }
+    auto residues_0 = std::vector<std::uint32_t>();
+    auto residues_1 = std::vector<std::uint32_t>();
+    auto residues_2 = std::vector<std::uint32_t>();
+    op_invoke(
+        rhs_size,
+        [&]() {
+          residues_0 =
+              ntt_convolution<NTT_PRIME_0>(lhs, lhs_size, rhs, rhs_size, n);
+        },
+        [&]() {
+          residues_1 =
+              ntt_convolution<NTT_PRIME_1>(lhs, lhs_size, rhs, rhs_size, n);
+        },
+        [&]() {
+          residues_2 =
+              ntt_convolution<NTT_PRIME_2>(lhs, lhs_size, rhs, rhs_size, n);
+        });
+
+    // Garner: x = r0 + p0 * (t1 + p1 * t2), where
+    //   t1 = (r1 - r0) / p0 (mod p1)
+    //   t2 = (r2 - r0 - p0 * t1) / (p0 * p1) (mod p2)
+    // x can be up to ~87 bits, so rather than 128-bit math, we split
+    // t = t1 + p1 * t2 (< p1 * p2 < 2^57) into two limbs and emit x as three
+    // base 10^9 limbs which get added into the result with a running carry
+    constexpr std::uint64_t p0_inverse_mod_p1 =
+        mod_pow(NTT_PRIME_0, NTT_PRIME_1 - 2, NTT_PRIME_1);
+    constexpr std::uint64_t p0p1_inverse_mod_p2 =
+        mod_pow((std::uint64_t)NTT_PRIME_0 * NTT_PRIME_1 % NTT_PRIME_2,
+                NTT_PRIME_2 - 2, NTT_PRIME_2);
+    constexpr std::uint64_t p0_mod_p2 = NTT_PRIME_0 % NTT_PRIME_2;
+    std::uint64_t pending_1 = 0; // 2nd limb of x[i - 1]
+    std::uint64_t pending_2 = 0; // 3rd limb of x[i - 1]
+    std::uint64_t carry = 0;
+    for (std::size_t i = 0; i < result_size; i++) {
+      std::uint64_t limb_0 = 0, limb_1 = 0, limb_2 = 0;
+      if (i < result_size - 1) {
+        std::uint64_t r0 = residues_0[i];
+        std::uint64_t r1 = residues_1[i];
+        std::uint64_t r2 = residues_2[i];
+        auto t1 = (r1 + NTT_PRIME_1 - r0 % NTT_PRIME_1) * p0_inverse_mod_p1 %
+                  NTT_PRIME_1;
+        auto t2 = (r2 + 2 * (std::uint64_t)NTT_PRIME_2 - r0 % NTT_PRIME_2 -
+                   p0_mod_p2 * t1 % NTT_PRIME_2) %
+                  NTT_PRIME_2 * p0p1_inverse_mod_p2 % NTT_PRIME_2;
+        auto t = t1 + (std::uint64_t)NTT_PRIME_1 * t2;
+        auto t_high = t / LIMB_BASE;
+        auto t_low = t % LIMB_BASE;
+        auto low = r0 + NTT_PRIME_0 * t_low;
+        auto middle = NTT_PRIME_0 * t_high + low / LIMB_BASE;
+        limb_0 = low % LIMB_BASE;
+        limb_1 = middle % LIMB_BASE;
+        limb_2 = middle / LIMB_BASE;
+      }
+      auto sum = limb_0 + pending_1 + carry;
+      result[i] = (limb_t)(sum % LIMB_BASE);
+      carry = sum / LIMB_BASE;
+      pending_1 = limb_1 + pending_2;
+      pending_2 = limb_2;
+    }
+    assert(carry == 0 && pending_1 == 0 && pending_2 == 0);
+  }
+
+  // helper for Toom-3 which needs signed intermediate values; wraps a range
+  // of limbs as a (trimmed) positive Large_Numbers
+  static Large_Numbers from_limbs(const limb_t *limbs, std::size_t size) {
+    size = significant_size(limbs, size);
+    if (size == 0) {
+      return Large_Numbers(int_revvec_t{0}, true);
+    }
+    return Large_Numbers(int_revvec_t(limbs, limbs + size), true);
+  }
+  static Large_Numbers multiply_signed(const Large_Numbers &lhs,
+                                       const Large_Numbers &rhs) {
+    auto product = op_multiply(lhs.value, rhs.value);
+    auto is_zero = product.size() == 1 && product[0] == 0;
+    return Large_Numbers(product,
+                         is_zero || (lhs.is_positive == rhs.is_positive));
+  }
+
+  // divides in-place by a single limb, returns the remainder; walks from the
+  // most significant limb, and because remainder < divisor <= 2^32, the
+  // remainder * 10^9 + limb always fits in double_limb_t
+  static limb_t op_divide_limb(limb_t *limbs, std::size_t size,
+                               limb_t divisor) {
+    double_limb_t remainder = 0;
+    for (auto i = size; i > 0; i--) {
+      auto current = remainder * LIMB_BASE + limbs[i - 1];
+      limbs[i - 1] = (limb_t)(current / divisor);
+      remainder = current % divisor;
+    }
+    return (limb_t)remainder;
+  }
+  // same as op_divide_limb() except that only the remainder is computed
+  // and limbs are left untouched
+  static limb_t op_modulo_limb(const limb_t *limbs, std::size_t size,
+                               limb_t divisor) {
+    double_limb_t remainder = 0;
+    for (auto i = size; i > 0; i--) {
+      remainder = (remainder * LIMB_BASE + limbs[i - 1]) % divisor;
+    }
+    return (limb_t)remainder;
+  }
+  // exact division (remainder must be 0) by a small number, keeps the sign
+  static Large_Numbers divide_exact_signed(Large_Numbers n, limb_t divisor) {
+    [[maybe_unused]] auto remainder =
+        op_divide_limb(n.value.data(), n.value.size(), divisor);
+    assert(remainder == 0);
+    while (n.value.size() > 1 && n.value.back() == 0) {
+      n.value.pop_back();
+    }
+    return n;
+  }
+
+  // Toom-Cook 3-way: split each operand in 3 parts a = a2*x^2 + a1*x + a0
+  // (x = B^k), evaluate both polynomials at 0, 1, -1, -2 and infinity, do 5
+  // pointwise multiplications of 1/3 size instead of 9, and then interpolate
+  // the product polynomial back (using Bodrato's sequence, which only needs
+  // exact division by 2 and 3)
+  // assumes lhs_size >= rhs_size > lhs_size / 2 (see op_multiply())
+  static void op_multiply_toom3(const limb_t *lhs, std::size_t lhs_size,
+                                const limb_t *rhs, std::size_t rhs_size,
+                                limb_t *result) {
+    auto k = (lhs_size + 2) / 3;
+    auto result_size = lhs_size + rhs_size;
+    auto part = [k](const limb_t *limbs, std::size_t size, std::size_t index) {
+      auto begin = std::min(size, index * k);
+      auto end = std::min(size, begin + k);
+      return from_limbs(limbs + begin, end - begin);
+    };
+    auto a0 = part(lhs, lhs_size, 0);
+    auto a1 = part(lhs, lhs_size, 1);
+    auto a2 = part(lhs, lhs_size, 2);
+    auto b0 = part(rhs, rhs_size, 0);
+    auto b1 = part(rhs, rhs_size, 1);
+    auto b2 = part(rhs, rhs_size, 2);
+
+    // evaluation: p(1) = a0 + a1 + a2, p(-1) = a0 - a1 + a2,
+    // p(-2) = a0 - 2 * a1 + 4 * a2 = 2 * (p(-1) + a2) - a0
+    auto a02 = a0 + a2;
+    auto pa_1 = a02 + a1;
+    auto pa_m1 = a02 - a1;
+    auto pa_m2 = ((pa_m1 + a2) + (pa_m1 + a2)) - a0;
+    auto b02 = b0 + b2;
+    auto pb_1 = b02 + b1;
+    auto pb_m1 = b02 - b1;
+    auto pb_m2 = ((pb_m1 + b2) + (pb_m1 + b2)) - b0;
+
+    // pointwise multiplication (recursive via op_multiply()); when squaring,
+    // multiplying each evaluation by itself makes them squares as well
+    auto squaring = lhs == rhs && lhs_size == rhs_size;
+    auto r0 = Zero(), r_1 = Zero(), r_m1 = Zero(), r_m2 = Zero();
+    auto r_inf = Zero();
+    op_invoke(
+        k, [&]() { r0 = multiply_signed(a0, squaring ? a0 : b0); },
+        [&]() { r_1 = multiply_signed(pa_1, squaring ? pa_1 : pb_1); },
+        [&]() { r_m1 = multiply_signed(pa_m1, squaring ? pa_m1 : pb_m1); },
+        [&]() { r_m2 = multiply_signed(pa_m2, squaring ? pa_m2 : pb_m2); },
+        [&]() { r_inf = multiply_signed(a2, squaring ? a2 : b2); });
+
+    // interpolation (Bodrato)
+    auto r3 = divide_exact_signed(r_m2 - r_1, 3);
+    auto r1 = divide_exact_signed(r_1 - r_m1, 2);
+    auto r2 = r_m1 - r0;
+    r3 = divide_exact_signed(r2 - r3, 2) + r_inf + r_inf;
+    r2 = (r2 + r1) - r_inf;
+    r1 = r1 - r3;
+
+    // recomposition: all coefficients of the product polynomial are >= 0
+    std::fill(result, result + result_size, 0);
+    const Large_Numbers *coefficients[] = {&r0, &r1, &r2, &r3, &r_inf};
+    for (std::size_t i = 0; i < 5; i++) {
+      const auto &coefficient = *coefficients[i];
+      assert(coefficient.is_positive || coefficient.Is_Zero());
+      if (i * k < result_size) {
+        op_add_at(result + i * k, result_size - i * k,
+                  coefficient.value.data(), coefficient.value.size());
+      }
+    }
+  }
+  // three-way compare of magnitudes (-1 if lhs < rhs, 0 if equal, 1 if
+  // lhs > rhs), both trimmed; compare(), op_equal(), op_less_than() and the
+  // division engine are all built on it
+  static int op_compare(const limb_t *lhs, std::size_t lhs_size,
+                        const limb_t *rhs, std::size_t rhs_size) {
+    if (lhs_size != rhs_size) {
+      return lhs_size < rhs_size ? -1 : 1;
+    }
+    return lhs_size >= LIMB_KERNEL_MIN_SIZE
+               ? limb_kernels().compare_n(lhs, rhs, lhs_size)
+               : op_compare_n_scalar(lhs, rhs, lhs_size);
+  }
+  static int op_compare(const int_revvec_t &lhs, const int_revvec_t &rhs) {
+    return op_compare(lhs.data(), lhs.size(), rhs.data(), rhs.size());
+  }
+  static void trim_limbs(int_revvec_t &limbs) {
+    while (limbs.size() > 1 && limbs.back() == 0) {
+      limbs.pop_back();
+    }
+  }
+  // (lhs + rhs) and (lhs - rhs) for the division engine which works with
+  // whole vectors; lhs >= rhs for the subtraction
+  static int_revvec_t op_add_limbs(const int_revvec_t &lhs,
+                                   const int_revvec_t &rhs) {
+    auto wider = lhs.size() >= rhs.size() ? &lhs : &rhs;
+    auto narrower = lhs.size() >= rhs.size() ? &rhs : &lhs;
+    auto result = int_revvec_t(wider->size() + 1, 0);
+    std::copy(wider->begin(), wider->end(), result.begin());
+    op_add_at(result.data(), result.size(), narrower->data(),
+              narrower->size());
+    trim_limbs(result);
+    return result;
+  }
+  static int_revvec_t op_subtract_limbs(const int_revvec_t &lhs,
+                                        const int_revvec_t &rhs) {
+    auto result = lhs;
+    op_subtract_at(result.data(), result.size(), rhs.data(), rhs.size());
+    trim_limbs(result);
+    return result;
+  }
+  // multiply/divide by B^shift (B = 10^9), which is just inserting/erasing
+  // whole limbs at the least significant end
+  static int_revvec_t op_shift_limbs_left(const int_revvec_t &limbs,
+                                          std::size_t shift) {
+    auto result = int_revvec_t(limbs.size() + shift, 0);
+    std::copy(limbs.begin(), limbs.end(), result.begin() + shift);
+    trim_limbs(result);
+    return result;
+  }
+  static int_revvec_t op_shift_limbs_right(const int_revvec_t &limbs,
+                                           std::size_t shift) {
+    if (shift >= limbs.size()) {
+      return int_revvec_t{0};
+    }
+    return int_revvec_t(limbs.begin() + shift, limbs.end());
+  }
+
+  // magnitude division engine, returns (quotient, remainder):
+  // * divisor is a single limb: one pass of op_divide_limb()
+  // * otherwise both get normalized (multiplied by d so that the top limb of
+  //   the divisor is >= B / 2, which keeps quotient digit estimates within 2
+  //   of the real one) and we do either Knuth D or Newton reciprocal
+  static std::tuple<int_revvec_t /*quotient*/, int_revvec_t /*remainder*/>
+  op_divide(const int_revvec_t &lhs, const int_revvec_t &rhs) {
+    if (rhs.size() == 1 && rhs[0] == 0) {
+      throw std::invalid_argument("Division by zero");
+    }
+    if (op_compare(lhs, rhs) < 0) {
+      return {int_revvec_t{0}, lhs};
+    }
+    if (rhs.size() == 1) {
+      auto quotient = lhs;
+      auto remainder =
+          op_divide_limb(quotient.data(), quotient.size(), rhs[0]);
+      trim_limbs(quotient);
+      return {quotient, int_revvec_t{remainder}};
+    }
+
+    auto d = (limb_t)(LIMB_BASE / ((double_limb_t)rhs.back() + 1));
+    auto u = int_revvec_t(lhs.size() + 1);
+    op_multiply_limb(lhs.data(), lhs.size(), d, u.data());
+    auto v = int_revvec_t(rhs.size() + 1);
+    op_multiply_limb(rhs.data(), rhs.size(), d, v.data());
+    trim_limbs(v); // v * d never grows, u * d might (hence the extra limb)
+
+    auto quotient = int_revvec_t();
+    auto remainder = int_revvec_t();
+    if (v.size() >= Divide_Thresholds::newton &&
+        u.size() - v.size() >= Divide_Thresholds::newton) {
+      std::tie(quotient, remainder) = op_divide_newton(u, v);
+    } else {
+      quotient = op_divide_knuth(u, v);
+      remainder = int_revvec_t(u.begin(), u.begin() + v.size());
+    }
+    // un-normalize the remainder (it is an exact multiple of d)
+    op_divide_limb(remainder.data(), remainder.size(), d);
+    trim_limbs(quotient);
+    trim_limbs(remainder);
+    return {quotient, remainder};
+  }
+
+  // Knuth TAOCP vol.2 4.3.1 Algorithm D (long division where each "digit" is
+  // a limb); v must be normalized (top limb >= B / 2) with at least 2 limbs,
+  // and u must have one more (possibly 0) limb than the normalized dividend.
+  // Returns the quotient, and u is overwritten with the remainder in its
+  // lower v.size() limbs
+  static int_revvec_t op_divide_knuth(int_revvec_t &u, const int_revvec_t &v) {
+    auto n = v.size();
+    auto quotient = int_revvec_t(u.size() - n, 0);
+    double_limb_t v_top = v[n - 1];
+    double_limb_t v_next = v[n - 2];
+    for (auto j = u.size() - n; j-- > 0;) {
+      // estimate quotient limb from the top 2 limbs of the current remainder
+      // and the top limb of v, then refine with the next limb of v
+      auto numerator = (double_limb_t)u[j + n] * LIMB_BASE + u[j + n - 1];
+      auto q_hat = numerator / v_top;
+      auto r_hat = numerator % v_top;
+      while (q_hat >= LIMB_BASE ||
+             q_hat * v_next > r_hat * LIMB_BASE + u[j + n - 2]) {
+        q_hat--;
+        r_hat += v_top;
+        if (r_hat >= LIMB_BASE) {
+          break;
+        }
+      }
+
+      // multiply and subtract: u[j..j+n] -= q_hat * v
+      double_limb_t carry = 0;
+      std::int64_t borrow = 0;
+      for (std::size_t i = 0; i < n; i++) {
+        auto product = q_hat * v[i] + carry;
+        carry = product / LIMB_BASE;
+        auto diff = (std::int64_t)u[i + j] - borrow -
+                    (std::int64_t)(product - carry * LIMB_BASE);
+        borrow = diff < 0 ? 1 : 0;
+        u[i + j] = (limb_t)(diff + borrow * LIMB_BASE);
+      }
+      auto top = (std::int64_t)u[j + n] - borrow - (std::int64_t)carry;
+
+      // q_hat was one too large (rare), add v back once
+      if (top < 0) {
+        q_hat--;
+        limb_t add_carry = 0;
+        for (std::size_t i = 0; i < n; i++) {
+          limb_t sum = u[i + j] + v[i] + add_carry;
+          add_carry = sum >= LIMB_BASE ? 1 : 0;
+          u[i + j] = sum - add_carry * LIMB_BASE;
+        }
+        top += add_carry;
+      }
+      u[j + n] = (limb_t)top;
+      quotient[j] = (limb_t)q_hat;
+    }
+    return quotient;
+  }
+
+  // floor(B^(2n) / v) for a normalized v of n limbs, by Newton's iteration
+  // X' = X + X * (B^(2n) - v * X) / B^(2n), which doubles the number of
+  // correct limbs per step; so we recurse on the top half of v to get a
+  // half-precision seed, do one Newton step at full size, and then fix up
+  // the last unit or two so that the result is exact
+  static int_revvec_t op_reciprocal(const int_revvec_t &v) {
+    auto n = v.size();
+    auto b_2n = int_revvec_t(2 * n + 1, 0);
+    b_2n.back() = 1;
+    if (n <= std::max<std::size_t>(Divide_Thresholds::newton / 2, 4)) {
+      b_2n.push_back(0); // op_divide_knuth() needs the extra limb
+      return op_divide_knuth(b_2n, v);
+    }
+
+    auto h = n / 2 + 2;
+    auto seed = op_reciprocal(int_revvec_t(v.end() - h, v.end()));
+    auto x = op_shift_limbs_left(seed, n - h);
+
+    auto v_x = op_multiply(v, x);
+    if (op_compare(v_x, b_2n) <= 0) {
+      auto error = op_subtract_limbs(b_2n, v_x);
+      x = op_add_limbs(x, op_shift_limbs_right(op_multiply(x, error), 2 * n));
+    } else {
+      auto error = op_subtract_limbs(v_x, b_2n);
+      auto correction =
+          op_shift_limbs_right(op_multiply(x, error), 2 * n);
+      x = op_subtract_limbs(x, correction);
+    }
+
+    // exact fix-up: we want 0 <= B^(2n) - v * x < v
+    v_x = op_multiply(v, x);
+    auto one = int_revvec_t{1};
+    while (op_compare(v_x, b_2n) > 0) {
+      x = op_subtract_limbs(x, one);
+      v_x = op_subtract_limbs(v_x, v);
+    }
+    while (op_compare(op_subtract_limbs(b_2n, v_x), v) >= 0) {
+      x = op_add_limbs(x, one);
+      v_x = op_add_limbs(v_x, v);
+    }
+    return x;
+  }
+
+  // Newton (Barrett-like) division for wide divisors: with the reciprocal
+  // X = floor(B^(2n) / v), the dividend is consumed n limbs at a time
+  // (just like long division, except each "digit" is a block of n limbs) and
+  // each block quotient is estimated by two multiplications instead of n
+  // Knuth D steps; v must be normalized
+  static std::tuple<int_revvec_t /*quotient*/, int_revvec_t /*remainder*/>
+  op_divide_newton(const int_revvec_t &u, const int_revvec_t &v) {
+    auto n = v.size();
+    auto x = op_reciprocal(v);
+    auto u_size = u.size();
+    auto quotient = int_revvec_t(u_size, 0);
+    auto remainder = int_revvec_t{0};
+    // first (top) block may be partial so that the rest are aligned
+    auto block_begin = u_size - (u_size % n == 0 ? n : u_size % n);
+    for (;;) {
+      // a = remainder * B^n + block (which is < v * B^n, so block quotient
+      // fits in n limbs)
+      auto block_end = std::min(u_size, block_begin + n);
+      auto block_size = block_end - block_begin;
+      auto a = int_revvec_t(remainder.size() + block_size, 0);
+      std::copy(u.begin() + block_begin, u.begin() + block_end, a.begin());
+      std::copy(remainder.begin(), remainder.end(), a.begin() + block_size);
+      trim_limbs(a);
+
+      // q ~= floor(a / B^(n-1)) * X / B^(n+1), which underestimates the
+      // real block quotient by at most a few units
+      auto q = op_shift_limbs_right(
+          op_multiply(op_shift_limbs_right(a, n - 1), x), n + 1);
+      auto q_v = op_multiply(q, v);
+      auto one = int_revvec_t{1};
+      auto steps = 0;
+      while (op_compare(q_v, a) > 0) {
+        q = op_subtract_limbs(q, one);
+        q_v = op_subtract_limbs(q_v, v);
+      }
+      remainder = op_subtract_limbs(a, q_v);
+      while (op_compare(remainder, v) >= 0) {
+        if (++steps > 4) {
+          // estimate was way off (should not happen), finish with Knuth D
+          auto knuth_u = remainder;
+          knuth_u.push_back(0);
+          q = op_add_limbs(q, op_divide_knuth(knuth_u, v));
+          knuth_u.resize(n);
+          remainder = knuth_u;
+          trim_limbs(remainder);
+          break;
+        }
+        q = op_add_limbs(q, one);
+        remainder = op_subtract_limbs(remainder, v);
+      }
+      for (std::size_t i = 0; i < q.size() && block_begin + i < u_size;
+           i++) {
+        quotient[block_begin + i] = q[i];
+      }
+      if (block_begin == 0) {
+        break;
+      }
+      block_begin -= n;
+    }
+    trim_limbs(quotient);
+    return {quotient, remainder};
+  }
+
+  // GCD engine.  Every reduction step is a unimodular 2x2 matrix U (integer
+  // entries, determinant +-1) taking (a, b) to U * (a, b), so gcd(a, b) is
+  // preserved whatever U is, and a product of such matrices taking (a, b)
+  // to (g, 0) has the cofactors of xgcd() in its first row.  Matrices are
+  // {u00, u01, u10, u11}, row major
+  typedef std::array<Large_Numbers, 4> Gcd_Matrix;
+
+  static Gcd_Matrix identity_matrix() {
+    return {Large_Numbers(vec_one, true), Zero(), Zero(),
+            Large_Numbers(vec_one, true)};
+  }
+  // lhs * rhs
+  static Gcd_Matrix op_multiply_matrix(const Gcd_Matrix &lhs,
+                                       const Gcd_Matrix &rhs) {
+    return {lhs[0] * rhs[0] + lhs[1] * rhs[2],
+            lhs[0] * rhs[1] + lhs[1] * rhs[3],
+            lhs[2] * rhs[0] + lhs[3] * rhs[2],
+            lhs[2] * rhs[1] + lhs[3] * rhs[3]};
+  }
+  // (a, b) = matrix * (a, b), then the rows are negated/swapped so that
+  // a >= b >= 0 again (which keeps the matrix unimodular)
+  static void op_apply_matrix(Gcd_Matrix &matrix, Large_Numbers &a,
+                              Large_Numbers &b) {
+    auto new_a = matrix[0] * a + matrix[1] * b;
+    b = matrix[2] * a + matrix[3] * b;
+    a = std::move(new_a);
+    if (!a.is_positive) {
+      a = -a;
+      matrix[0] = -matrix[0];
+      matrix[1] = -matrix[1];
+    }
+    if (!b.is_positive) {
+      b = -b;
+      matrix[2] = -matrix[2];
+      matrix[3] = -matrix[3];
+    }
+    if (op_compare(a.value, b.value) < 0) {
+      std::swap(a, b);
+      std::swap(matrix[0], matrix[2]);
+      std::swap(matrix[1], matrix[3]);
+    }
+  }
+  // one Euclid step (a, b) = (b, a mod b), b != 0
+  static void op_gcd_division_step(Large_Numbers &a, Large_Numbers &b,
+                                   Gcd_Matrix *matrix) {
+    auto [quotient, remainder] = op_divide(a.value, b.value);
+    a = std::move(b);
+    b = Large_Numbers(std::move(remainder), true);
+    if (matrix != nullptr) {
+      // rows (r0, r1) -> (r1, r0 - q * r1)
+      auto q = Large_Numbers(std::move(quotient), true);
+      auto &m = *matrix;
+      auto new_u10 = m[0] - q * m[2];
+      auto new_u11 = m[1] - q * m[3];
+      m[0] = std::move(m[2]);
+      m[1] = std::move(m[3]);
+      m[2] = std::move(new_u10);
+      m[3] = std::move(new_u11);
+    }
+  }
+  // Lehmer: runs Euclid on the leading 2 limbs of a and b (the same limb
+  // positions of both) with single precision cofactors, for as long as
+  // Knuth's test (TAOCP vol.2 4.5.2 Algorithm L) proves the quotients are
+  // those of the full numbers, then applies all of them at once in a single
+  // pass over the limbs; a >= b, a with >= 2 limbs and b at most one limb
+  // shorter.  Returns false if not even one quotient could be proven
+  static bool op_lehmer_step(Large_Numbers &a, Large_Numbers &b,
+                             Gcd_Matrix *matrix) {
+    auto n = a.value.size();
+    auto limb_at = [](const int_revvec_t &limbs, std::size_t i) {
+      return i < limbs.size() ? (std::int64_t)limbs[i] : std::int64_t(0);
+    };
+    auto a_hat = limb_at(a.value, n - 1) * LIMB_BASE + limb_at(a.value, n - 2);
+    auto b_hat = limb_at(b.value, n - 1) * LIMB_BASE + limb_at(b.value, n - 2);
+    // cofactors of (a, b) = (A * a + B * b, C * a + D * b)
+    std::int64_t A = 1, B = 0, C = 0, D = 1;
+    while (b_hat + C > 0 && b_hat + D > 0) {
+      auto q = (a_hat + A) / (b_hat + C);
+      if (q != (a_hat + B) / (b_hat + D)) {
+        break;
+      }
+      auto next_C = A - q * C;
+      auto next_D = B - q * D;
+      // keeps cofactor * limb (+ the other) within an int64 below
+      if (std::max(std::abs(next_C), std::abs(next_D)) >= LIMB_BASE) {
+        break;
+      }
+      A = C;
+      B = D;
+      C = next_C;
+      D = next_D;
+      auto next_b_hat = a_hat - q * b_hat;
+      a_hat = b_hat;
+      b_hat = next_b_hat;
+    }
+    if (B == 0) {
+      return false;
+    }
+    b.value.resize(n, 0);
+    std::int64_t carry_a = 0, carry_b = 0;
+    auto floor_divide = [](std::int64_t value) {
+      return value >= 0 ? value / LIMB_BASE
+                        : -((-value + LIMB_BASE - 1) / LIMB_BASE);
+    };
+    for (std::size_t i = 0; i < n; i++) {
+      std::int64_t a_i = a.value[i], b_i = b.value[i];
+      auto new_a = A * a_i + B * b_i + carry_a;
+      auto new_b = C * a_i + D * b_i + carry_b;
+      carry_a = floor_divide(new_a);
+      carry_b = floor_divide(new_b);
+      a.value[i] = (limb_t)(new_a - carry_a * LIMB_BASE);
+      b.value[i] = (limb_t)(new_b - carry_b * LIMB_BASE);
+    }
+    assert(carry_a == 0 && carry_b == 0); // both stay >= 0, and shrink
+    trim_limbs(a.value);
+    trim_limbs(b.value);
+    if (matrix != nullptr) {
+      auto step = Gcd_Matrix{Large_Numbers(A), Large_Numbers(B),
+                             Large_Numbers(C), Large_Numbers(D)};
+      *matrix = op_multiply_matrix(step, *matrix);
+    }
+    return true;
+  }
+  // half-GCD: a matrix taking (a, b) (a >= b >= 0, n limbs) to about n / 2
+  // limbs, from the leading limbs alone: Euclid's quotients only depend on
+  // the leading half of the numbers for as long as the remainders are
+  // longer than that half, so the top n - n / 2 limbs are reduced first
+  // (recursively, to about 3n / 4 limbs for the whole numbers), and then
+  // the top of what is left once more.  Should the last quotients of a
+  // truncated pair differ from the real ones, op_apply_matrix() just
+  // restores a >= b >= 0 (U stays unimodular, so nothing is lost)
+  static Gcd_Matrix op_hgcd(const Large_Numbers &a, const Large_Numbers &b) {
+    auto n = a.value.size();
+    auto matrix = identity_matrix();
+    auto reduced_a = a;
+    auto reduced_b = b;
+    if (n < Gcd_Thresholds::hgcd) {
+      op_gcd_reduce(reduced_a, reduced_b, n / 2, &matrix);
+      return matrix;
+    }
+    auto top = [](const Large_Numbers &x, std::size_t shift) {
+      return Large_Numbers(op_shift_limbs_right(x.value, shift), true);
+    };
+    auto half = n / 2;
+    if (b.value.size() <= half) {
+      return matrix;
+    }
+    matrix = op_hgcd(top(a, half), top(b, half));
+    op_apply_matrix(matrix, reduced_a, reduced_b);
+    if (reduced_b.value.size() <= half || reduced_b.Is_Zero()) {
+      return matrix;
+    }
+    op_gcd_division_step(reduced_a, reduced_b, &matrix);
+    auto remaining = reduced_a.value.size();
+    if (reduced_b.value.size() <= half || remaining <= half) {
+      return matrix;
+    }
+    // reducing the top 2 * (remaining - half) limbs by half of that lands
+    // the whole numbers around n / 2 limbs
+    auto shift = remaining > 2 * (remaining - half)
+                     ? remaining - 2 * (remaining - half)
+                     : 0;
+    auto second = op_hgcd(top(reduced_a, shift), top(reduced_b, shift));
+    return op_multiply_matrix(second, matrix);
+  }
+  // reduces (a, b), a >= b >= 0, until b has at most stop limbs (or is 0),
+  // keeping a >= b; matrix (if any) accumulates the steps
+  static void op_gcd_reduce(Large_Numbers &a, Large_Numbers &b,
+                            std::size_t stop, Gcd_Matrix *matrix) {
+    auto hgcd = matrix != nullptr ? Gcd_Thresholds::hgcd
+                                  : Gcd_Thresholds::hgcd_no_cofactors;
+    while (!b.Is_Zero() && b.value.size() > stop) {
+      auto a_size = a.value.size();
+      auto b_size = b.value.size();
+      if (b_size + 1 < a_size) {
+        // one big quotient: a single division beats anything else
+        op_gcd_division_step(a, b, matrix);
+      } else if (a_size >= hgcd) {
+        auto step = op_hgcd(a, b);
+        op_apply_matrix(step, a, b);
+        if (matrix != nullptr) {
+          *matrix = op_multiply_matrix(step, *matrix);
+        }
+        if (!b.Is_Zero()) {
+          op_gcd_division_step(a, b, matrix); // always some progress
+        }
+      } else if (a_size < 2 || !op_lehmer_step(a, b, matrix)) {
+        op_gcd_division_step(a, b, matrix);
+      }
+    }
+  }
+  static std::uint64_t limbs_to_u64(const int_revvec_t &limbs) {
+    std::uint64_t value = 0;
+    for (auto i = limbs.size(); i > 0; i--) {
+      value = value * LIMB_BASE + limbs[i - 1];
+    }
+    return value;
+  }
+  // Stein's binary GCD: shifts and subtractions only
+  static std::uint64_t binary_gcd(std::uint64_t a, std::uint64_t b) {
+    if (a == 0 || b == 0) {
+      return a | b;
+    }
+    auto shift = std::countr_zero(a | b);
+    a >>= std::countr_zero(a);
+    while (b != 0) {
+      b >>= std::countr_zero(b);
+      if (a > b) {
+        std::swap(a, b);
+      }
+      b -= a;
+    }
+    return a << shift;
+  }
+
+  // which residues mod M are squares
+  template <std::size_t M> static const std::array<bool, M> &square_residues() {
+    static constexpr auto residues = [] {
+      auto result = std::array<bool, M>{};
+      for (std::size_t i = 0; i < M; i++) {
+        result[i * i % M] = true;
+      }
+      return result;
+    }();
+    return residues;
+  }
+  // k-th root of n >= 0, rounded down; see iroot()
+  static Large_Numbers op_root(const Large_Numbers &n, std::uint64_t k) {
+    auto size = n.value.size();
+    if (k == 1 || (size == 1 && n.value[0] <= 1)) {
+      return n;
+    }
+    if (k >= size * 30) {
+      return Large_Numbers(vec_one, true); // n < 10^(9 size) < 2^(30 size)
+    }
+    auto root_size = size / k + (size % k != 0 ? 1 : 0);
+    Large_Numbers x;
+    if (root_size <= 2) {
+      // root < 10^18: a floating point estimate of it from the leading limbs
+      // (relative error ~1e-15), pushed upwards by far more than that
+      auto top = (double)n.value[size - 1];
+      for (std::size_t i = 2; i <= std::min<std::size_t>(size, 3); i++) {
+        top = top * LIMB_BASE + n.value[size - i];
+      }
+      auto low_limbs = size - std::min<std::size_t>(size, 3);
+      auto log10_n = std::log10(top) + LIMB_DIGITS * (double)low_limbs;
+      auto estimate = std::pow(10.0, log10_n / (double)k) * (1.0 + 1e-9) + 2;
+      x = Large_Numbers((std::uint64_t)std::min(estimate, 1e19));
+    } else {
+      // n < (top + 1) * B^(k * shift) <= (root(top) + 1)^k * B^(k * shift),
+      // so this seed is above the root, by at most a relative 1 / root(top);
+      // keeping one more limb of the root than shifted out makes one Newton
+      // step (which squares that error) land within a few units of it
+      auto shift = (root_size - 1) / 2;
+      auto top = Large_Numbers(op_shift_limbs_right(n.value, k * shift), true);
+      auto top_root = op_root(top, k);
+      top_root += Large_Numbers(vec_one, true);
+      x = Large_Numbers(op_shift_limbs_left(top_root.value, shift), true);
+    }
+    auto x_power = pow(x, k - 1);
+    auto power = x_power * x;
+    while (op_compare(power.value, n.value) <= 0) {
+      // only a floating point seed can be below the root
+      x = x + x;
+      x_power = pow(x, k - 1);
+      power = x_power * x;
+    }
+    // from above the root, Newton's x' = ((k - 1) x + n / x^(k-1)) / k
+    // decreases strictly until it reaches floor(root)
+    auto degree = Large_Numbers(k);
+    while (op_compare(power.value, n.value) > 0) {
+      x = (Large_Numbers(k - 1) * x + n / x_power) / degree;
+      x_power = pow(x, k - 1);
+      power = x_power * x;
+    }
+    return x;
+  }
+
+  // bits of an exponent, least significant first and without leading zeros
+  // (so 0 has none)
+  static std::vector<bool> exponent_bits(std::uint64_t exp) {
+    auto bits = std::vector<bool>();
+    for (; exp > 0; exp >>= 1) {
+      bits.push_back(exp & 1);
+    }
+    return bits;
+  }
+  static std::vector<bool> exponent_bits(const int_revvec_t &exp) {
+    constexpr limb_t chunk = limb_t(1) << 30; // 30 bits per division
+    auto magnitude = exp;
+    auto bits = std::vector<bool>();
+    while (!(magnitude.size() == 1 && magnitude[0] == 0)) {
+      auto remainder = op_divide_limb(magnitude.data(), magnitude.size(), chunk);
+      trim_limbs(magnitude);
+      for (std::size_t i = 0; i < 30; i++) {
+        bits.push_back((remainder >> i) & 1);
+      }
+    }
+    while (!bits.empty() && !bits.back()) {
+      bits.pop_back();
+    }
+    return bits;
+  }
+  // left-to-right sliding window exponentiation: walking the bits from the
+  // top, every bit costs a squaring, and each window of up to `window` bits
+  // ending in a 1 costs a single multiplication by a precomputed odd power
+  // base^1, base^3, ..., base^(2^window - 1); i.e. for a 1000-bit exponent,
+  // ~1000 squarings and ~170 multiplications rather than ~500
+  template <typename T, typename Square, typename Multiply>
+  static T op_sliding_window(const T &base, const T &one,
+                             const std::vector<bool> &bits,
+                             const Square &square, const Multiply &multiply) {
+    if (bits.empty()) {
+      return one;
+    }
+    std::size_t window = bits.size() > 671   ? 6
+                         : bits.size() > 239 ? 5
+                         : bits.size() > 79  ? 4
+                         : bits.size() > 23  ? 3
+                         : bits.size() > 6   ? 2
+                                             : 1;
+    auto odd_powers = std::vector<T>{base};
+    if (window > 1) {
+      auto base_squared = square(base);
+      for (std::size_t i = 1; i < (std::size_t(1) << (window - 1)); i++) {
+        odd_powers.push_back(multiply(odd_powers.back(), base_squared));
+      }
+    }
+    auto result = std::optional<T>(); // the top bit is a 1 so it starts there
+    for (auto top = bits.size(); top > 0;) {
+      if (!bits[top - 1]) {
+        result = square(*result);
+        top--;
+        continue;
+      }
+      // window is bits [bottom, top), trimmed so that its lowest bit is a 1
+      auto bottom = top > window ? top - window : 0;
+      while (!bits[bottom]) {
+        bottom++;
+      }
+      std::size_t value = 0;
+      for (auto bit = top; bit > bottom; bit--) {
+        value = value * 2 + bits[bit - 1];
+      }
+      if (result) {
+        for (auto bit = bottom; bit < top; bit++) {
+          result = square(*result);
+        }
+        result = multiply(*result, odd_powers[value / 2]);
       } else {
-        // because right < left, doing (right - left) will need swapped
-        // to (left - right) and negate
-        result = op_subtract(left_clone, right_clone); // left > right
-        result_is_positive = false;
-      }
-    }
-
-    // finally, reverse the result
-    std::tuple<bool, int_revvec_t> result_tuple = {result_is_positive, result};
-    return result_tuple;
-  }
-
-  std::tuple<bool /*is_positive*/, int_revvec_t /*digits*/> op_multiply_tuple(
-      std::tuple<bool /*is_positive*/, int_revvec_t /*digits*/> left,
-      std::tuple<bool /*is_positive*/, int_revvec_t /*digits*/> right) const {
-    std::cout << "op_multiply_tuple:" << std::endl;
-    std::cout << "\tleft (is_positive=" << std::get<0>(left) << ")  :";
-    dump_digits(left);
-    std::cout << std::endl;
-    std::cout << "\tright (is_positive=" << std::get<0>(right) << ") :";
-    dump_digits(right);
-    std::cout << std::endl;
-
-    auto lhs_clone = std::get<1>(left);
-    auto rhs_clone = std::get<1>(right);
-    // if lhs > 0 && rhs > 0, result > 0 (pos * pos = pos)
-    // if lhs < 0 && rhs < 0, result > 0 (neg * neg = pos)
-    // if lhs > 0 && rhs < 0, result < 0 (pos * neg = neg)
-    // if lhs < 0 && rhs > 0, result < 0 (neg * pos = neg)
-    bool result_is_positive = (std::get<0>(left) == std::get<0>(right));
-
-    // simple edge cases: if either is zero, then the result is zero
-    if (lhs_clone.size() == 0 || rhs_clone.size() == 0 ||
-        (lhs_clone.size() == 1 && lhs_clone[0] == 0) ||
-        (rhs_clone.size() == 1 && rhs_clone[0] == 0)) {
-      return {true, vec_zero};
-    }
-    // if either is 1, then the result is the other
-    if (lhs_clone.size() == 1 && lhs_clone[0] == 1) {
-      return {result_is_positive, rhs_clone};
-    } else if (rhs_clone.size() == 1 && rhs_clone[0] == 1) {
-      return {result_is_positive, lhs_clone};
-    }
-    // if either is multiples of 10's (10, 100, ... 10^n), then just shift
-    // the digits to the left, or more to the point, append 0's the tail of the
-    // other number.  i.e. 123 * 100 = 12300
-    bool lhs_is_power_of_10 = is_multiple_of_10(lhs_clone);
-    bool rhs_is_power_of_10 = is_multiple_of_10(rhs_clone);
-  }
-  std::tuple<bool /*is_positive*/, int_revvec_t /*digits*/> op_divide_tuple(
-      std::tuple<bool /*is_positive*/, int_revvec_t /*digits*/> left,
-      std::tuple<bool /*is_positive*/, int_revvec_t /*digits*/> right) const {
-    std::cout << "op_divide_tuple:" << std::endl;
-    std::cout << "\tleft (is_positive=" << std::get<0>(left) << ")  :";
-    dump_digits(left);
-    std::cout << std::endl;
-    std::cout << "\tright (is_positive=" << std::get<0>(right) << ") :";
-    dump_digits(right);
-    std::cout << std::endl;
-
-    // not implemented yet
-    throw std::invalid_argument("Not implemented yet");
-  }
-  std::tuple<bool /*is_positive*/, int_revvec_t /*digits*/> op_modulo_tuple(
-      std::tuple<bool /*is_positive*/, int_revvec_t /*digits*/> left,
-      std::tuple<bool /*is_positive*/, int_revvec_t /*digits*/> right) const {
-    std::cout << "op_modulo_tuple:" << std::endl;
-    std::cout << "\tleft (is_positive=" << std::get<0>(left) << ")  :";
-    dump_digits(left);
-    std::cout << std::endl;
-    std::cout << "\tright (is_positive=" << std::get<0>(right) << ") :";
-    dump_digits(right);
-    std::cout << std::endl;
-
-    // not implemented yet
-    throw std::invalid_argument("Not implemented yet");
+        result = odd_powers[value / 2];
+      }
+      top = bottom;
+    }
+    return std::move(*result);
   }
 
   // ideally, I'd probably want to have functions jut for finding fibonacci
   // that are within the range to fit in uint64_t, but it'll just cause
   // code-pollutions, so we'll just handle all cases in one function...
   // constraints: for fibonacci, n must be > 0
-  int_revvec_t fibonacci_large_rec(int_revvec_t n) {
+  int_revvec_t fibonacci_large_rec(const int_revvec_t &n) {
     if (n.size() == 0) {
       throw std::invalid_argument("n must be > 0");
     }
@@ -847,12 +3700,13 @@ private:
       result.push_back(1);
       return result;
     }
-    auto n_minus_1 = op_subtract(n, {1});
-    auto n_minus_2 = op_subtract(n, {2});
-    auto fib_n_minus_1 = fibonacci_large_rec(n_minus_1);
-    auto fib_n_minus_2 = fibonacci_large_rec(n_minus_2);
-    auto added = op_add(fib_n_minus_1, fib_n_minus_2);
-    return added;
+    auto n_minus_1 = Large_Numbers(n, true);
+    n_minus_1 -= std::int64_t(1);
+    auto n_minus_2 = n_minus_1;
+    n_minus_2 -= std::int64_t(1);
+    auto added = Large_Numbers(fibonacci_large_rec(n_minus_1.value), true);
+    added += Large_Numbers(fibonacci_large_rec(n_minus_2.value), true);
+    return std::move(added.value);
   }
 
   std::int64_t to_i64() {
@@ -860,13 +3714,17 @@ private:
     // value
     auto v = this->value;
     auto trimmed = trim(v);
-    if (trimmed.size() > 19) {
+    // 3 limbs is up to 27 digits, so only the top limb < 9 (9 * 10^18) fits
+    if ((trimmed.size() > 3) || (trimmed.size() == 3 && trimmed[2] >= 9)) {
       throw std::invalid_argument("Number too large to fit in i64");
     }
 
     std::int64_t result = 0;
+    for (auto limb = trimmed.rbegin(); limb != trimmed.rend(); limb++) {
+      result = result * LIMB_BASE + *limb;
+    }
 
-    return result;
+    return this->is_positive ? result : -result;
   }
 
   int_revvec_t fibonacci_large_iter() {
@@ -882,23 +3740,27 @@ private:
     if (n == 1) {
       return {1};
     }
-    auto n_minus_1 = int_revvec_t{1};
-    auto n_minus_2 = int_revvec_t{0};
-    auto fib_n = int_revvec_t{};
+    auto n_minus_1 = Large_Numbers(int_revvec_t{1}, true);
+    auto n_minus_2 = Large_Numbers(int_revvec_t{0}, true);
     // begin iteration from 2..=n
-    for (auto i = 2; i <= n; i++) {
+    for (uint64_t i = 2; i <= n; i++) {
       // fib(n) = fib(n-1) + fib(n-2); 34 = 21 + 13
       // fib(n-1) = fib(n-2) + fib(n-3) ; 21 = 13 + 8
-      fib_n = op_add(n_minus_1, n_minus_2);
-      n_minus_2 = n_minus_1;
-      n_minus_1 = fib_n;
+      // fib(n-2) is not needed after this, so fib(n) is added in-place into
+      // its buffer, and then the two are swapped (moved, not copied)
+      n_minus_2 += n_minus_1;
+      std::swap(n_minus_1, n_minus_2);
     }
 
-    this->value = fib_n;
-    return fib_n;
+    this->value = n_minus_1.value;
+    return std::move(n_minus_1.value);
   }
 
 public:
+  // defined after Fibonacci_Sequence, which needs a complete Large_Numbers
+  static void unit_test_fibonacci();
+  // ditto, Mapped_File
+  static void unit_test_serialization();
   static void unit_test() {
     auto start = std::chrono::high_resolution_clock::now();
     // if lambda is recursive, it must be defined as a std::function separately
@@ -962,6 +3824,744 @@ public:
     assert(result_add.Is_Zero());
     assert(result_subtract == Large_Numbers(9876543210 * 2));
 
+    std::clog << "Testing limbs (base 10^9):" << std::endl;
+    // carry-over and borrow across the limb boundary
+    const auto limb_max = Large_Numbers("999999999");
+    const auto one = Large_Numbers(std::int64_t(1));
+    auto result_carry = limb_max + one;
+    dump_digits(result_carry);
+    std::clog << std::endl;
+    assert(result_carry.value.size() == 2);
+    assert(result_carry.Get() == "1000000000");
+    assert(result_carry.Size() == 10);
+    assert((result_carry - one) == limb_max);
+    assert(test_from_string.Get() == "1234567890");
+    assert(test_from_string_negative.Get() == "-1234567890");
+    assert(test_trim.Get() == "1234567890");
+    assert(Large_Numbers("000").Is_Zero());
+    assert(Large_Numbers("12345678901234567890123").Size() == 23);
+    assert(Large_Numbers(std::uint64_t(18446744073709551615ULL)).Get() ==
+           "18446744073709551615");
+    assert((Large_Numbers("-5") + Large_Numbers("3")).Get() == "-2");
+    assert((Large_Numbers("-5") + Large_Numbers("-3")).Get() == "-8");
+
+    std::clog << "Testing limb kernels (using " << limb_kernels().name
+              << "):" << std::endl;
+    {
+      // limbs drawn from {0, 1, 10^9 - 2, 10^9 - 1, random} so that long
+      // carry/borrow chains across the SIMD lanes and blocks show up
+      auto kernel_rng = std::mt19937(12345);
+      auto edgy_limbs = [&kernel_rng](std::size_t size) {
+        auto limbs = std::vector<limb_t>(size);
+        for (auto &limb : limbs) {
+          switch (kernel_rng() % 5) {
+          case 0: limb = 0; break;
+          case 1: limb = 1; break;
+          case 2: limb = LIMB_BASE - 2; break;
+          case 3: limb = LIMB_BASE - 1; break;
+          default: limb = kernel_rng() % LIMB_BASE; break;
+          }
+        }
+        return limbs;
+      };
+      auto kernels = available_limb_kernels();
+      auto &scalar = kernels.back();
+      for (const auto &kernel : kernels) {
+        for (std::size_t size : {0, 1, 3, 4, 5, 7, 8, 9, 16, 17, 33, 100}) {
+          for (auto round = 0; round < 50; round++) {
+            auto lhs = edgy_limbs(size);
+            auto rhs = round == 0 ? lhs : edgy_limbs(size);
+            auto expected = std::vector<limb_t>(size);
+            auto actual = std::vector<limb_t>(size);
+            assert(kernel.add_n(actual.data(), lhs.data(), rhs.data(), size) ==
+                   scalar.add_n(expected.data(), lhs.data(), rhs.data(), size));
+            assert(actual == expected);
+            assert(kernel.subtract_n(actual.data(), lhs.data(), rhs.data(),
+                                     size) ==
+                   scalar.subtract_n(expected.data(), lhs.data(), rhs.data(),
+                                     size));
+            assert(actual == expected);
+            assert(kernel.compare_n(lhs.data(), rhs.data(), size) ==
+                   scalar.compare_n(lhs.data(), rhs.data(), size));
+            // in place, out aliasing lhs
+            expected = lhs;
+            scalar.add_n(expected.data(), expected.data(), rhs.data(), size);
+            kernel.add_n(lhs.data(), lhs.data(), rhs.data(), size);
+            assert(lhs == expected);
+          }
+        }
+      }
+    }
+
+    std::clog << "Testing parsing (from_chars):" << std::endl;
+    assert(Large_Numbers("1,234,567_890'123 456").Get() == "1234567890123456");
+    assert(Large_Numbers("-000000000000000001234.999").Get() == "-1234");
+    assert(Large_Numbers("-0").Is_Positive());
+    assert(Large_Numbers("000000000000000000000000").Is_Zero());
+    assert(Large_Numbers("1000000000000000000").value.size() == 3);
+    auto parsed = Large_Numbers(std::int64_t(42));
+    std::string_view not_a_number = "-,x";
+    auto parse_failed = from_chars(not_a_number, parsed);
+    assert(parse_failed.ec == std::errc::invalid_argument);
+    assert(parse_failed.ptr == not_a_number.data());
+    assert(parsed.Get() == "42"); // untouched on error
+    std::string_view trailing = "123456789012 apples";
+    auto parse_partial = from_chars(trailing, parsed);
+    assert(parse_partial.ec == std::errc() && *parse_partial.ptr == 'a');
+    assert(parsed.Get() == "123456789012");
+    auto parse_threw = false;
+    try {
+      Large_Numbers("12a34");
+    } catch (const std::invalid_argument &) {
+      parse_threw = true;
+    }
+    assert(parse_threw);
+    // every digit count modulo 9 for the left-over group
+    auto random_digits = std::string("1");
+    auto digit_generator = std::mt19937(20240229);
+    for (auto digits = 1; digits < 200; digits++) {
+      assert(Large_Numbers(random_digits).Get() == random_digits);
+      random_digits.push_back(static_cast<char>('0' + digit_generator() % 10));
+    }
+
+    std::clog << "Testing formatting (to_chars):" << std::endl;
+    auto formatted = Large_Numbers("-1000000000000000007");
+    assert(formatted.Get(25) == "-0000001000000000000000007");
+    assert(formatted.Get(22, ' ') == "-   1000000000000000007");
+    assert(formatted.Get(5) == "-1000000000000000007");
+    assert(Large_Numbers("0").Get(3) == "000");
+    assert(formatted.to_chars_length(25) == 26);
+    char small_buffer[8];
+    auto format_failed = formatted.to_chars(small_buffer, small_buffer + 8);
+    assert(format_failed.ec == std::errc::value_too_large);
+    assert(format_failed.ptr == small_buffer + 8);
+    char exact_buffer[20];
+    auto format_exact = formatted.to_chars(exact_buffer, exact_buffer + 20);
+    assert(format_exact.ec == std::errc() && format_exact.ptr == exact_buffer + 20);
+    assert(std::string_view(exact_buffer, 20) == "-1000000000000000007");
+
+    std::clog << "Testing streaming (operator<<, write_to):" << std::endl;
+    auto streamed = std::ostringstream();
+    streamed << formatted << ' ' << std::setw(8) << Large_Numbers("-42") << ' '
+             << std::setfill('*') << std::setw(3) << Large_Numbers("12345");
+    assert(streamed.str() == "-1000000000000000007      -42 12345");
+    // long enough for several chunks
+    auto long_number = Large_Numbers(random_digits + random_digits);
+    for (auto i = 0; i < 6; i++) {
+      long_number *= long_number;
+    }
+    long_number = -long_number;
+    streamed.str("");
+    long_number.write_to(streamed);
+    assert(streamed.str() == long_number.Get());
+    auto temporary_file = std::tmpfile();
+    if (temporary_file != nullptr) {
+      auto written = long_number.write_to(temporary_file);
+      auto file_size = std::ftell(temporary_file);
+      std::rewind(temporary_file);
+      auto from_file = std::string(file_size, '\0');
+      auto read = std::fread(from_file.data(), 1, file_size, temporary_file);
+      std::fclose(temporary_file);
+      assert(written && read == static_cast<std::size_t>(file_size));
+      assert(from_file == long_number.Get());
+    }
+
+    std::clog << "Testing multiplication:" << std::endl;
+    auto mul_lhs = Large_Numbers("12345678901234567890");
+    auto result_multiply = mul_lhs * Large_Numbers("-98765432109876543210");
+    dump_digits(result_multiply);
+    std::clog << std::endl;
+    assert(result_multiply.Get() ==
+           "-1219326311370217952237463801111263526900");
+    auto nines = Large_Numbers("999999999999999999");
+    assert((nines * nines).Get() == "999999999999999998000000000000000001");
+    assert((mul_lhs * zero).Is_Zero());
+    assert((mul_lhs * Large_Numbers("1000000000000000000")).Get() ==
+           "12345678901234567890000000000000000000");
+
+    // randomized: every algorithm (forced by lowering the thresholds so that
+    // the sizes stay small) must agree with plain schoolbook, around each
+    // crossover and for unbalanced operands
+    auto rng = std::mt19937(20240229);
+    auto random_limbs = [&rng](std::size_t size) {
+      auto limbs = int_revvec_t(size);
+      for (auto &limb : limbs) {
+        limb = rng() % LIMB_BASE;
+      }
+      limbs.back() = limbs.back() == 0 ? 1 : limbs.back();
+      return limbs;
+    };
+    auto saved_karatsuba = Multiply_Thresholds::karatsuba;
+    auto saved_toom3 = Multiply_Thresholds::toom3;
+    Multiply_Thresholds::karatsuba = 4;
+    Multiply_Thresholds::toom3 = 12;
+    for (std::size_t lhs_size : {1, 2, 3, 4, 5, 11, 12, 13, 40, 97}) {
+      for (std::size_t rhs_size : {1, 3, 4, 5, 12, 13, 40}) {
+        auto a = random_limbs(lhs_size);
+        auto b = random_limbs(rhs_size);
+        auto expected = int_revvec_t(lhs_size + rhs_size);
+        op_multiply_schoolbook(a.data(), a.size(), b.data(), b.size(),
+                               expected.data());
+        while (expected.size() > 1 && expected.back() == 0) {
+          expected.pop_back();
+        }
+        assert(op_multiply(a, b) == expected);
+      }
+    }
+
+    // NTT vs schoolbook: around the NTT threshold itself and on both sides of
+    // each power of 2 transform size (lhs_size + rhs_size - 1 == 2^k), plus
+    // all limbs = 10^9 - 1 which is the biggest convolution coefficient
+    auto saved_ntt = Multiply_Thresholds::ntt;
+    Multiply_Thresholds::ntt = 8;
+    for (std::size_t lhs_size :
+         {7, 8, 9, 16, 17, 31, 32, 33, 64, 65, 127, 128, 129, 1000}) {
+      for (std::size_t rhs_size : {7, 8, 9, 16, 17, 33, 128, 129}) {
+        for (auto worst_case : {false, true}) {
+          auto a = random_limbs(lhs_size);
+          auto b = random_limbs(rhs_size);
+          if (worst_case) {
+            std::fill(a.begin(), a.end(), LIMB_BASE - 1);
+            std::fill(b.begin(), b.end(), LIMB_BASE - 1);
+          }
+          auto expected = int_revvec_t(lhs_size + rhs_size);
+          op_multiply_schoolbook(a.data(), a.size(), b.data(), b.size(),
+                                 expected.data());
+          while (expected.size() > 1 && expected.back() == 0) {
+            expected.pop_back();
+          }
+          assert(op_multiply(a, b) == expected);
+        }
+      }
+    }
+
+    // squaring (same limbs on both sides) vs schoolbook, with every
+    // algorithm taking its squaring path
+    for (auto ntt : {saved_ntt, std::size_t(8)}) {
+      Multiply_Thresholds::ntt = ntt;
+      for (std::size_t size : {1, 2, 3, 4, 5, 12, 13, 40, 97, 1000}) {
+        auto a = random_limbs(size);
+        auto expected = int_revvec_t(2 * size);
+        op_multiply_schoolbook(a.data(), a.size(), a.data(), a.size(),
+                               expected.data());
+        trim_limbs(expected);
+        assert(op_multiply(a, a) == expected);
+      }
+    }
+
+    std::clog << "Testing parallel multiplication:" << std::endl;
+    auto pool = Thread_Pool(4);
+    auto parallel = Parallel{&pool, 8};
+    for (std::size_t lhs_size : {5, 13, 40, 200, 1000}) {
+      auto a = Large_Numbers::Zero();
+      auto b = Large_Numbers::Zero();
+      a.value = random_limbs(lhs_size);
+      b.value = random_limbs(lhs_size - 3);
+      b.is_positive = false;
+      auto expected = a * b;
+      Multiply_Thresholds::ntt = lhs_size == 1000 ? 8 : saved_ntt;
+      assert(a.multiply(b, parallel) == expected);
+      assert(b.multiply(a, parallel) == expected);
+    }
+    // a pool of 0 threads gets one; with one, products stay on this thread
+    for (std::size_t threads : {0, 1}) {
+      auto small_pool = Thread_Pool(threads);
+      assert(small_pool.Size() == 1);
+      auto a = Fibonacci(100000);
+      assert(a.multiply(a, Parallel{&small_pool, 16}) == a * a);
+    }
+    auto failing_group = Task_Group(pool);
+    failing_group.Run([]() { throw std::invalid_argument("task"); });
+    failing_group.Run([]() {});
+    auto rethrown = false;
+    try {
+      failing_group.Wait();
+    } catch (const std::invalid_argument &) {
+      rethrown = true;
+    }
+    assert(rethrown);
+
+    std::clog << "Testing batch operations:" << std::endl;
+    auto batch_operands =
+        std::vector<std::pair<Large_Numbers, Large_Numbers>>();
+    auto batch_terms = std::vector<Large_Numbers>();
+    auto expected_sum = Large_Numbers::Zero();
+    for (std::size_t i = 0; i < 200; i++) {
+      auto term = Large_Numbers::Zero();
+      term.value = random_limbs(1 + rng() % 30);
+      term.is_positive = rng() % 3 != 0;
+      expected_sum += term;
+      batch_terms.push_back(term);
+      batch_operands.emplace_back(term, batch_terms[rng() % (i + 1)]);
+    }
+    batch_terms.push_back(-expected_sum); // the total cancels out to 0
+    for (auto batch_parallel : {Parallel{&pool, 1}, Parallel{&pool, 1 << 30}}) {
+      auto batch_results = std::vector<Large_Numbers>(batch_operands.size(),
+                                                      Large_Numbers::Zero());
+      add_batch(batch_operands, batch_results, batch_parallel);
+      for (std::size_t i = 0; i < batch_operands.size(); i++) {
+        assert(batch_results[i] ==
+               batch_operands[i].first + batch_operands[i].second);
+      }
+      auto terms = std::span<const Large_Numbers>(batch_terms);
+      assert(sum(terms.first(200), batch_parallel) == expected_sum);
+      assert(sum(terms, batch_parallel).Is_Zero());
+      assert(sum(terms.first(1), batch_parallel) == batch_terms[0]);
+      assert(sum(terms.first(0), batch_parallel).Is_Zero());
+    }
+    auto all_limbs_max = Large_Numbers::Zero();
+    all_limbs_max.value = int_revvec_t(5, LIMB_BASE - 1);
+    auto many_max = std::vector<Large_Numbers>(1000, all_limbs_max);
+    assert(sum(many_max, parallel) ==
+           all_limbs_max * Large_Numbers(std::uint64_t(1000)));
+
+    std::clog << "Testing accumulator:" << std::endl;
+    auto accumulator_sum = Accumulator();
+    auto accumulator_other = Accumulator();
+    auto accumulator_expected = Large_Numbers::Zero();
+    for (std::size_t i = 0; i < batch_operands.size(); i++) {
+      auto &term = batch_operands[i].first;
+      // scales wide enough to overflow the columns every few terms
+      auto scale = static_cast<std::int64_t>(rng()) * (i % 2 ? 1 : -1);
+      accumulator_sum.Add(term, scale);
+      accumulator_expected += term * Large_Numbers(scale);
+      accumulator_other -= term;
+      accumulator_expected -= term;
+      accumulator_other += std::int64_t(i) - 100;
+      accumulator_expected += Large_Numbers(std::int64_t(i) - 100);
+    }
+    accumulator_sum.Add(batch_operands[0].first, INT64_MIN);
+    accumulator_expected +=
+        batch_operands[0].first * Large_Numbers(std::int64_t(INT64_MIN));
+    accumulator_sum -= std::int64_t(INT64_MIN);
+    accumulator_expected -= Large_Numbers(std::int64_t(INT64_MIN));
+    accumulator_sum += accumulator_other;
+    assert(accumulator_sum.Result() == accumulator_expected);
+    accumulator_sum += accumulator_expected; // keeps going after Result()
+    assert(accumulator_sum.Result() ==
+           accumulator_expected * Large_Numbers(std::int64_t(2)));
+    accumulator_sum.Clear();
+    assert(accumulator_sum.Result().Is_Zero());
+    // columns filled right up to the edge, where the carries of normalize()
+    // used to wrap around
+    auto edge_sum = Accumulator();
+    auto edge_term = Large_Numbers(std::uint64_t(999999999999999999));
+    for (auto scale : std::initializer_list<std::int64_t>{
+             4294967295, 4294967295, 4294967295, 4294967295, 1266874912}) {
+      edge_sum.Add(edge_term, scale);
+    }
+    assert(edge_sum.Result() ==
+           Large_Numbers("18446744091999999981553255908"));
+    Multiply_Thresholds::ntt = saved_ntt;
+    Multiply_Thresholds::karatsuba = saved_karatsuba;
+    Multiply_Thresholds::toom3 = saved_toom3;
+
+    std::clog << "Testing compound assignment (in-place):" << std::endl;
+    auto accumulator = Large_Numbers::Zero();
+    accumulator.value.reserve(4);
+    auto accumulator_buffer = accumulator.value.data();
+    for (std::int64_t i = 1; i <= 100000; i++) {
+      accumulator += i; // sum(1..n) = n * (n + 1) / 2
+    }
+    assert(accumulator.Get() == "5000050000");
+    // capacity was enough, so the buffer never moved (no temporaries)
+    assert(accumulator.value.data() == accumulator_buffer);
+    auto running = Large_Numbers(std::int64_t(5));
+    running -= Large_Numbers("12");
+    assert(running.Get() == "-7");
+    running += Large_Numbers("7");
+    assert(running.Is_Zero() && running.Is_Positive());
+    running -= std::int64_t(1000000000);
+    running -= Large_Numbers("-1999999999");
+    assert(running.Get() == "999999999");
+    running += running; // aliasing
+    assert(running.Get() == "1999999998");
+    running *= Large_Numbers("-1000000001");
+    assert(running.Get() == "-1999999999999999998");
+    running /= Large_Numbers(std::int64_t(-2));
+    assert(running.Get() == "999999999999999999");
+    running %= Large_Numbers("1000000000000");
+    assert(running.Get() == "999999999999");
+    running %= Large_Numbers(std::int64_t(10));
+    assert(running.Get() == "9");
+    running *= std::int64_t(-3);
+    assert(running.Get() == "-27");
+    running -= running; // aliasing
+    assert(running.Is_Zero());
+
+    std::clog << "Testing comparison (compare, <=>):" << std::endl;
+    {
+      auto minus_big = Large_Numbers("-1000000000000000000000");
+      auto minus_small = Large_Numbers("-999999999999999999999");
+      auto plus_small = Large_Numbers("999999999999999999999");
+      assert(minus_big < minus_small && minus_small < Zero());
+      assert(minus_big.compare(minus_small) == -1);
+      assert(minus_small.compare(minus_big) == 1);
+      assert(plus_small > minus_big && plus_small >= plus_small);
+      assert((minus_small <=> minus_small) == std::strong_ordering::equal);
+      assert(minus_small != -minus_small);
+      assert(Large_Numbers("-0") == Zero() && !(Large_Numbers("-0") < Zero()));
+      // sort and binary search against the same keys as int64_t
+      auto keys = std::vector<std::int64_t>();
+      auto key_rng = std::mt19937(7);
+      for (auto i = 0; i < 500; i++) {
+        auto magnitude = static_cast<std::int64_t>(key_rng() % 100000) *
+                         (i % 3 == 0 ? 1 : 1000000007LL);
+        keys.push_back(i % 2 == 0 ? magnitude : -magnitude);
+      }
+      auto sorted = std::vector<Large_Numbers>();
+      for (auto key : keys) {
+        sorted.push_back(Large_Numbers(key));
+      }
+      std::sort(keys.begin(), keys.end());
+      std::sort(sorted.begin(), sorted.end());
+      for (std::size_t i = 0; i < keys.size(); i++) {
+        assert(sorted[i] == Large_Numbers(keys[i]));
+        assert(std::binary_search(sorted.begin(), sorted.end(),
+                                  Large_Numbers(keys[i])));
+      }
+    }
+
+    std::clog << "Testing move semantics:" << std::endl;
+    auto temporary = with_capacity(lhs, 8);
+    auto temporary_buffer = temporary.value.data();
+    auto chained = std::move(temporary) + lhs + rhs + lhs; // reuses buffer
+    assert(chained == lhs + lhs);
+    assert(chained.value.data() == temporary_buffer);
+    auto negated = -lhs; // unary minus no longer flips lhs itself
+    assert(!negated.Is_Positive() && lhs.Is_Positive());
+    assert((lhs - Large_Numbers("1")) == -(Large_Numbers("1") - lhs));
+    // moved-from numbers are a valid 0, usable as any other
+    auto moved_from = -Fibonacci(300);
+    auto moved_to = Large_Numbers(std::move(moved_from));
+    assert(moved_from.Is_Zero() && moved_from.Is_Positive());
+    assert(moved_from.Size() == 1 && moved_from.Get() == "0");
+    assert(moved_from.compare(Zero()) == 0 && moved_from < moved_to * moved_to);
+    moved_to = std::move(moved_to);
+    assert(moved_to == -Fibonacci(300));
+    moved_from = std::move(moved_to);
+    assert(moved_to.Is_Zero() && moved_to.Is_Positive());
+    moved_to += moved_from;
+    assert(moved_to == -Fibonacci(300));
+
+    std::clog << "Testing small buffer (inline limbs):" << std::endl;
+    auto heap_allocations_before = Limb_Vector::heap_allocations.load();
+    {
+      auto small = Large_Numbers(std::int64_t(123456789012345));
+      auto small_rhs = Large_Numbers(std::uint64_t(42));
+      auto small_sum = small + small_rhs;
+      small_sum -= small_rhs;
+      small_sum *= std::int64_t(7);
+      small_sum += std::int64_t(-3);
+      auto small_product = small_sum * small_rhs;
+      assert(small_product.Get() == "36296295969629304");
+    }
+    auto heap_allocations_small =
+        Limb_Vector::heap_allocations.load() - heap_allocations_before;
+    std::clog << "heap allocations for small-value arithmetic: "
+              << heap_allocations_small << std::endl;
+    assert(heap_allocations_small == 0);
+    auto spilled = Limb_Vector(Limb_Vector::INLINE_CAPACITY + 1, 7);
+    auto spilled_moved = std::move(spilled); // steals the heap buffer
+    assert(spilled_moved.size() == Limb_Vector::INLINE_CAPACITY + 1);
+    assert(spilled.empty() && spilled.is_inline());
+
+    std::clog << "Testing memory resources (arena):" << std::endl;
+    auto forty_digits = Large_Numbers("1234567890123456789012345678901234567890");
+    auto expected_square = forty_digits * forty_digits;
+    {
+      // everything must come out of the fixed buffer, or it throws
+      std::array<std::byte, 4096> fixed_buffer;
+      std::pmr::monotonic_buffer_resource fixed(
+          fixed_buffer.data(), fixed_buffer.size(),
+          std::pmr::null_memory_resource());
+      Memory_Resource_Scope scope(&fixed);
+      auto square = forty_digits * forty_digits;
+      assert(square.value.resource() == &fixed);
+      assert(square == expected_square);
+      assert(scope.Previous() == std::pmr::get_default_resource());
+    }
+    auto arena_result = Large_Numbers::Zero();
+    {
+      Arena arena;
+      auto sum = Large_Numbers::Zero();
+      for (auto i = 0; i < 100; i++) {
+        sum = sum + forty_digits * forty_digits;
+        sum *= forty_digits; // scratch buffer must not keep arena memory
+        sum = sum / forty_digits;
+      }
+      arena_result = arena.Keep(sum);
+      assert(arena_result.value.resource() == std::pmr::get_default_resource());
+    }
+    assert(arena_result == expected_square * Large_Numbers(std::int64_t(100)));
+    // numbers from outside of an Arena keep their own resource when given
+    // results made inside it (move assignment, or swap in / and %)
+    auto outer_quotient = expected_square * forty_digits;
+    auto outer_remainder = outer_quotient + Large_Numbers(std::int64_t(7));
+    {
+      Arena arena;
+      outer_quotient /= forty_digits;
+      outer_remainder %= forty_digits;
+      assert(outer_quotient.value.resource() ==
+             std::pmr::get_default_resource());
+    }
+    assert(outer_quotient == expected_square);
+    assert(outer_remainder == Large_Numbers(std::int64_t(7)));
+
+    unit_test_fibonacci();
+    unit_test_serialization();
+
+    std::clog << "Testing division:" << std::endl;
+    auto dividend = Large_Numbers("1219326311370217952237463801111263526901");
+    auto divisor = Large_Numbers("98765432109876543210");
+    auto result_divmod = dividend.divmod(divisor);
+    dump_digits(std::get<0>(result_divmod));
+    std::clog << " r ";
+    dump_digits(std::get<1>(result_divmod));
+    std::clog << std::endl;
+    assert(std::get<0>(result_divmod).Get() == "12345678901234567890");
+    assert(std::get<1>(result_divmod).Get() == "1");
+    assert((dividend / divisor).Get() == "12345678901234567890");
+    assert((dividend % divisor).Get() == "1");
+    // truncated towards zero, remainder takes the sign of the dividend
+    auto minus_seven = Large_Numbers(std::int64_t(-7));
+    auto result_negative = minus_seven.divmod(Large_Numbers(std::int64_t(2)));
+    assert(std::get<0>(result_negative).Get() == "-3");
+    assert(std::get<1>(result_negative).Get() == "-1");
+    auto result_small = dividend.divmod_small(10);
+    assert(std::get<0>(result_small).Get() ==
+           "121932631137021795223746380111126352690");
+    assert(std::get<1>(result_small) == 1);
+    bool division_by_zero_thrown = false;
+    try {
+      dividend.divmod(zero);
+    } catch (const std::invalid_argument &) {
+      division_by_zero_thrown = true;
+    }
+    assert(division_by_zero_thrown);
+
+    // randomized: quotient * divisor + remainder == dividend and
+    // remainder < divisor, for Knuth D and (forced) Newton reciprocal
+    auto saved_newton = Divide_Thresholds::newton;
+    for (std::size_t newton : {saved_newton, std::size_t(6)}) {
+      Divide_Thresholds::newton = newton;
+      for (std::size_t lhs_size : {2, 3, 7, 13, 40, 101, 300}) {
+        for (std::size_t rhs_size : {1, 2, 3, 6, 7, 12, 13, 40, 100}) {
+          auto a = Large_Numbers(random_limbs(lhs_size), true);
+          auto b = Large_Numbers(random_limbs(rhs_size), true);
+          if (rhs_size % 2 == 0) {
+            // small top limb, so normalization has to scale it up
+            b.value.back() = 1;
+          }
+          auto result = a.divmod(b);
+          auto q = std::get<0>(result);
+          auto r = std::get<1>(result);
+          assert(op_compare(r.value, b.value) < 0);
+          assert(q * b + r == a);
+        }
+      }
+    }
+    Divide_Thresholds::newton = saved_newton;
+
+    std::clog << "Testing pow, modpow:" << std::endl;
+    auto two = Large_Numbers(std::int64_t(2));
+    auto power_of_two = Large_Numbers(std::int64_t(1));
+    for (std::uint64_t exp = 0; exp <= 300; exp++) {
+      assert(pow(two, exp) == power_of_two);
+      power_of_two += power_of_two;
+    }
+    assert(pow(Large_Numbers(std::int64_t(-3)), 5).Get() == "-243");
+    assert(pow(Large_Numbers(std::int64_t(-3)), 4).Get() == "81");
+    assert(pow(zero, 0).Get() == "1" && pow(zero, 7).Is_Zero());
+    auto seven_to_1000 = Large_Numbers(std::int64_t(1));
+    for (std::size_t i = 0; i < 1000; i++) {
+      seven_to_1000 *= std::int64_t(7);
+    }
+    assert(pow(Large_Numbers(std::int64_t(7)), 1000) == seven_to_1000);
+    // small moduli against NTT's 64-bit mod_pow(): coprime to 10
+    // (Montgomery), even and multiples of 5 (Barrett)
+    for (std::uint32_t mod : {2u, 3u, 10u, 97u, 125u, 1000000007u, 999999999u,
+                              2147483648u, 4294967291u}) {
+      for (std::size_t i = 0; i < 20; i++) {
+        auto base = std::uint64_t(rng()) * rng();
+        auto exp = std::uint64_t(rng()) * (i % 4);
+        assert(modpow(Large_Numbers(base), Large_Numbers(exp),
+                      Large_Numbers(std::uint64_t(mod))) ==
+               Large_Numbers(std::uint64_t(mod_pow(base, exp, mod))));
+      }
+    }
+    assert(modpow(Large_Numbers(std::int64_t(-2)),
+                  Large_Numbers(std::int64_t(3)),
+                  Large_Numbers(std::int64_t(11)))
+               .Get() == "3"); // -8 mod 11
+    assert(modpow(two, zero, Large_Numbers(std::int64_t(1))).Is_Zero());
+    // Fermat: a^(p-1) = 1 mod p for the Mersenne prime 2^127 - 1
+    auto mersenne_127 = pow(two, 127) - Large_Numbers(std::int64_t(1));
+    assert(modpow(Large_Numbers(std::int64_t(3)),
+                  mersenne_127 - Large_Numbers(std::int64_t(1)), mersenne_127)
+               .Get() == "1");
+    // multi-limb moduli against pow() then %, with both reductions
+    auto saved_barrett = Modular_Thresholds::barrett;
+    for (std::size_t barrett : {saved_barrett, std::size_t(0)}) {
+      Modular_Thresholds::barrett = barrett;
+      for (std::size_t mod_size : {2, 5, 40}) {
+        for (limb_t low_digit : {1u, 3u, 4u, 5u}) {
+          auto base = Large_Numbers(random_limbs(mod_size + 3), true);
+          auto modulus = Large_Numbers(random_limbs(mod_size), true);
+          modulus.value[0] = modulus.value[0] / 10 * 10 + low_digit;
+          auto exp = std::uint64_t(rng() % 100);
+          assert(modpow(base, Large_Numbers(exp), modulus) ==
+                 pow(base, exp) % modulus);
+        }
+      }
+    }
+    Modular_Thresholds::barrett = saved_barrett;
+    bool bad_modulus_thrown = false;
+    try {
+      modpow(two, two, zero);
+    } catch (const std::invalid_argument &) {
+      bad_modulus_thrown = true;
+    }
+    assert(bad_modulus_thrown);
+
+    std::clog << "Testing modular context:" << std::endl;
+    for (std::size_t barrett : {saved_barrett, std::size_t(0)}) {
+      Modular_Thresholds::barrett = barrett;
+      for (std::size_t mod_size : {1, 3, 12}) {
+        for (limb_t low_digit : {3u, 5u, 8u}) {
+          auto modulus = Large_Numbers(random_limbs(mod_size), true);
+          modulus.value[0] = modulus.value[0] / 10 * 10 + low_digit;
+          auto context = Mod_Context(modulus);
+          assert(context.Is_Montgomery() ==
+                 (low_digit == 3 && mod_size < barrett));
+          auto a = Large_Numbers(random_limbs(mod_size + 2), false);
+          auto b = Large_Numbers(random_limbs(mod_size), true);
+          auto x = context.Reduce(a), y = context.Reduce(b);
+          auto expected_x = a % modulus + modulus; // % keeps a's sign
+          auto expected_y = b % modulus;
+          for (std::size_t i = 0; i < 50; i++) {
+            x = x * x + y - context.One();
+            expected_x = (expected_x * expected_x + expected_y -
+                          Large_Numbers(std::int64_t(1))) %
+                         modulus;
+            y -= x;
+            expected_y = (expected_y - expected_x) % modulus;
+            y *= y;
+            expected_y = expected_y * expected_y % modulus;
+          }
+          assert(x.Value() == (expected_x + modulus) % modulus);
+          assert(y.Value() == (expected_y + modulus) % modulus);
+          assert((x - x) == context.Zero() && (-y + y).Value().Is_Zero());
+          assert(x.Pow(Large_Numbers(std::int64_t(5))) == x * x * x * x * x);
+        }
+      }
+    }
+    Modular_Thresholds::barrett = saved_barrett;
+    auto context_7 = Mod_Context(Large_Numbers(std::int64_t(7)));
+    auto other_context_7 = Mod_Context(Large_Numbers(std::int64_t(7)));
+    assert(context_7.Reduce(Large_Numbers(std::int64_t(3)))
+               .Pow(Large_Numbers(int_revvec_t{0}, false)) == context_7.One());
+    bool mixed_contexts_thrown = false;
+    try {
+      context_7.One() + other_context_7.One();
+    } catch (const std::invalid_argument &) {
+      mixed_contexts_thrown = true;
+    }
+    assert(mixed_contexts_thrown);
+    auto context_1 = Mod_Context(Large_Numbers(std::int64_t(1)));
+    assert((context_1.Reduce(two) * context_1.One()).Value().Is_Zero());
+
+    std::clog << "Testing gcd, xgcd, modinv:" << std::endl;
+    auto euclid = [](Large_Numbers a, Large_Numbers b) {
+      a = Large_Numbers(a.value, true);
+      b = Large_Numbers(b.value, true);
+      while (!b.Is_Zero()) {
+        a = a % b;
+        std::swap(a, b);
+      }
+      return a;
+    };
+    auto saved_hgcd = Gcd_Thresholds::hgcd;
+    auto saved_hgcd_no_cofactors = Gcd_Thresholds::hgcd_no_cofactors;
+    for (std::size_t hgcd : {saved_hgcd, std::size_t(4)}) {
+      Gcd_Thresholds::hgcd = hgcd;
+      Gcd_Thresholds::hgcd_no_cofactors = hgcd;
+      for (std::size_t lhs_size : {1, 2, 3, 8, 30, 150}) {
+        for (std::size_t rhs_size : {1, 2, 7, 30, 150}) {
+          auto common = Large_Numbers(random_limbs(1 + rng() % 3), true);
+          auto a = Large_Numbers(random_limbs(lhs_size), true) * common;
+          auto b = Large_Numbers(random_limbs(rhs_size), rng() % 2) * common;
+          auto g = gcd(a, b);
+          assert(g == euclid(a, b) && g == gcd(b, a));
+          auto [xg, x, y] = xgcd(a, b);
+          assert(xg == g && a * x + b * y == g);
+          auto modulus = Large_Numbers(b.value, true) + g;
+          if (gcd(a, modulus) == Large_Numbers(std::int64_t(1))) {
+            auto inverse = modinv(a, modulus);
+            assert(inverse.Is_Positive() && inverse < modulus);
+            assert(inverse * a % modulus == Large_Numbers(std::int64_t(1)));
+          }
+        }
+      }
+    }
+    Gcd_Thresholds::hgcd = saved_hgcd;
+    Gcd_Thresholds::hgcd_no_cofactors = saved_hgcd_no_cofactors;
+    auto [zero_gcd, zero_x, zero_y] = xgcd(Zero(), Zero());
+    assert(zero_gcd.Is_Zero() && gcd(Zero(), Zero()).Is_Zero());
+    assert(gcd(Zero(), Large_Numbers(std::int64_t(-12))) ==
+           Large_Numbers(std::int64_t(12)));
+    assert(modinv(Large_Numbers(std::int64_t(-3)),
+                  Large_Numbers(std::int64_t(7))) ==
+           Large_Numbers(std::int64_t(2)));
+    bool not_invertible_thrown = false;
+    try {
+      modinv(Large_Numbers(std::int64_t(6)), Large_Numbers(std::int64_t(9)));
+    } catch (const std::invalid_argument &) {
+      not_invertible_thrown = true;
+    }
+    assert(not_invertible_thrown);
+
+    std::clog << "Testing isqrt, iroot, is_perfect_square:" << std::endl;
+    for (std::size_t size : {1, 2, 3, 5, 8, 40, 300}) {
+      for (std::uint64_t k : {2, 3, 5, 17}) {
+        auto n = Large_Numbers(random_limbs(size), true);
+        auto root = iroot(n, k);
+        auto next = root + Large_Numbers(std::int64_t(1));
+        assert(pow(root, k) <= n && pow(next, k) > n);
+        assert(iroot(pow(next, k), k) == next);
+        assert(iroot(pow(next, k) - Large_Numbers(std::int64_t(1)), k) ==
+               root);
+        if (k == 3) {
+          assert(iroot(-n, k) == -root);
+        }
+      }
+      auto root = isqrt(Large_Numbers(random_limbs(size), true));
+      auto square = root * root;
+      assert(is_perfect_square(square));
+      assert(!is_perfect_square(square + Large_Numbers(std::int64_t(1))) ||
+             root.Is_Zero());
+      assert(!is_perfect_square(square + root + root +
+                                Large_Numbers(std::int64_t(2))));
+    }
+    assert(isqrt(Zero()).Is_Zero() &&
+           isqrt(Large_Numbers(std::int64_t(99))) ==
+               Large_Numbers(std::int64_t(9)));
+    assert(iroot(Large_Numbers(std::int64_t(1) << 40), 40) ==
+           Large_Numbers(std::int64_t(2)));
+    assert(iroot(Large_Numbers(std::int64_t(-8)), 1000001) ==
+           Large_Numbers(std::int64_t(-1)));
+    assert(!is_perfect_square(Large_Numbers(std::int64_t(-4))));
+    auto negative_zero = Large_Numbers(int_revvec_t{0}, false);
+    assert(isqrt(negative_zero).Is_Zero() && is_perfect_square(negative_zero));
+    assert(iroot(negative_zero, 3).Is_Positive());
+    bool even_root_thrown = false;
+    try {
+      isqrt(Large_Numbers(std::int64_t(-4)));
+    } catch (const std::invalid_argument &) {
+      even_root_thrown = true;
+    }
+    assert(even_root_thrown);
+
     // now unit-test PRIVATE methods internal to THIS class (do NOT try to use
     // this method on public)
     auto my_large_number = Large_Numbers("0");
@@ -1007,13 +4607,779 @@ public:
     std::clog << "Result: ";
     my_large_number.dump_digits(result_reversed);
     std::clog << std::endl;
-    // assert(op_equal(expected, result));
+    assert(my_large_number.op_equal(std::get<1>(expected_reversed_tup),
+                                    result_reversed));
 
     auto end = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double> diff = end - start;
     std::clog << "Unit test duration: " << diff.count() << " s" << std::endl;
   }
 };
+
+inline bool Thread_Pool::Run_Pending_Task() {
+  auto task = std::function<void()>();
+  auto own = current_pool == this ? current_worker : queues.size();
+  if (own < queues.size()) {
+    auto lock = std::lock_guard<std::mutex>(queues[own]->mutex);
+    if (!queues[own]->tasks.empty()) {
+      task = std::move(queues[own]->tasks.back());
+      queues[own]->tasks.pop_back();
+    }
+  }
+  for (std::size_t i = 1; !task && i <= queues.size(); i++) {
+    auto &victim = *queues[(own + i) % queues.size()];
+    auto lock = std::lock_guard<std::mutex>(victim.mutex);
+    if (!victim.tasks.empty()) {
+      task = std::move(victim.tasks.front());
+      victim.tasks.pop_front();
+    }
+  }
+  if (!task) {
+    return false;
+  }
+  pending--;
+  // a Parallel is only inherited by the tasks op_invoke() forks for it
+  struct Restore {
+    const Large_Numbers::Parallel *previous;
+    ~Restore() { Large_Numbers::parallel_context = previous; }
+  } restore{Large_Numbers::parallel_context};
+  Large_Numbers::parallel_context = nullptr;
+  task();
+  return true;
+}
+
+#ifdef LARGE_NUMBERS_HAS_MMAP
+// Read-only memory mapping of a whole file (POSIX only), mainly so that a
+// serialized number can be wrapped by a Large_Numbers::View without reading
+// it in, i.e.
+//
+//    auto file = Mapped_File("fibonacci_10e9.lnum");
+//    auto f_n = Large_Numbers::View::From_Bytes(file.Data(), file.Size());
+//    auto doubled = Large_Numbers(std::int64_t(2)) * f_n;
+//
+// Views over it must not outlive the Mapped_File
+class Mapped_File {
+public:
+  explicit Mapped_File(const std::string &path) {
+    auto fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      throw std::invalid_argument("Cannot open '" + path + "'");
+    }
+    struct stat status;
+    if (::fstat(fd, &status) != 0) {
+      ::close(fd);
+      throw std::invalid_argument("Cannot stat '" + path + "'");
+    }
+    size = static_cast<std::size_t>(status.st_size);
+    if (size > 0) {
+      data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    ::close(fd); // the mapping keeps the file alive
+    if (data == MAP_FAILED) {
+      data = nullptr;
+      throw std::invalid_argument("Cannot map '" + path + "'");
+    }
+  }
+  ~Mapped_File() {
+    if (data != nullptr) {
+      ::munmap(data, size);
+    }
+  }
+  Mapped_File(const Mapped_File &) = delete;
+  Mapped_File &operator=(const Mapped_File &) = delete;
+
+  const void *Data() const { return data; }
+  std::size_t Size() const { return size; }
+
+private:
+  void *data = nullptr;
+  std::size_t size = 0;
+};
+#endif // LARGE_NUMBERS_HAS_MMAP
+
+// Walks F(start), F(start+1), ... one term at a time: each Next() is a
+// single in-place addition into the buffer of the term that is no longer
+// needed, so (other than the occasional growth by a limb) nothing is
+// allocated per step.  i.e. scanning for the first term with N digits:
+//
+//    auto sequence = Large_Numbers::Fibonacci_Sequence(12);
+//    while (sequence.Current().Size() < N) {
+//      sequence.Next();
+//    }
+class Large_Numbers::Fibonacci_Sequence {
+public:
+  explicit Fibonacci_Sequence(std::uint64_t start = 0)
+      : current(Zero()), next(Zero()), index(start) {
+    std::tie(current, next) = fibonacci_pair(start);
+  }
+  // F(Index())
+  const Large_Numbers &Current() const { return current; }
+  std::uint64_t Index() const { return index; }
+  // advances to F(Index() + 1) and returns it
+  const Large_Numbers &Next() {
+    current += next; // F(k) + F(k+1) = F(k+2), in F(k)'s buffer
+    std::swap(current, next);
+    index++;
+    return current;
+  }
+
+private:
+  Large_Numbers current; // F(index)
+  Large_Numbers next;    // F(index + 1)
+  std::uint64_t index;
+};
+
+// Policies for Sequence_Cache: a policy describes the state kept at each
+// checkpoint and how to get to the state at n, either from scratch (At()) or
+// by jumping ahead steps terms from a known state (Advance())
+//
+// Every sequence with G(n+2) = G(n+1) + G(n) (Fibonacci, Lucas, ...) is a
+// combination of Fibonacci numbers, so jumping ahead by m works for all:
+//    G(k+m)   = F(m-1) * G(k) + F(m)   * G(k+1)
+//    G(k+m+1) = F(m)   * G(k) + F(m+1) * G(k+1)
+// short jumps are cheaper as plain additions
+struct Fibonacci_Type_Policy {
+  typedef std::tuple<Large_Numbers, Large_Numbers> State; // {G(n), G(n+1)}
+  static inline std::uint64_t incremental_steps = 64;
+
+  static State Advance(const State &state, std::uint64_t steps) {
+    auto [g_k, g_k_plus_1] = state;
+    if (steps <= incremental_steps) {
+      for (std::uint64_t step = 0; step < steps; step++) {
+        g_k += g_k_plus_1;
+        std::swap(g_k, g_k_plus_1);
+      }
+      return {std::move(g_k), std::move(g_k_plus_1)};
+    }
+    auto [f_m_minus_1, f_m] = Large_Numbers::fibonacci_pair(steps - 1);
+    auto f_m_plus_1 = f_m_minus_1 + f_m;
+    auto g_k_plus_m = f_m_minus_1 * g_k;
+    g_k_plus_m += f_m * g_k_plus_1;
+    auto g_k_plus_m_plus_1 = f_m * g_k;
+    g_k_plus_m_plus_1 += f_m_plus_1 * g_k_plus_1;
+    return {std::move(g_k_plus_m), std::move(g_k_plus_m_plus_1)};
+  }
+  // approximate, it's only used to keep within the memory budget
+  // (9 decimal digits per 32-bit limb)
+  static std::size_t Bytes(const State &state) {
+    return sizeof(State) + (std::get<0>(state).Size() / 9 +
+                            std::get<1>(state).Size() / 9 + 2) *
+                               sizeof(std::uint32_t);
+  }
+};
+struct Fibonacci_Policy : Fibonacci_Type_Policy {
+  static State At(std::uint64_t n) { return Large_Numbers::fibonacci_pair(n); }
+};
+// Lucas numbers L(0) = 2, L(1) = 1:
+//    L(n) = 2 * F(n+1) - F(n), L(n+1) = 2 * F(n) + F(n+1)
+struct Lucas_Policy : Fibonacci_Type_Policy {
+  static State At(std::uint64_t n) {
+    auto [f_n, f_n_plus_1] = Large_Numbers::fibonacci_pair(n);
+    auto l_n = f_n_plus_1 + f_n_plus_1;
+    l_n -= f_n;
+    auto l_n_plus_1 = f_n + f_n;
+    l_n_plus_1 += f_n_plus_1;
+    return {std::move(l_n), std::move(l_n_plus_1)};
+  }
+};
+
+// Indices are visited in increasing order within each chunk, so that close
+// ones are walked to by additions (as Fibonacci_Type_Policy::Advance() would)
+// rather than doubled to from scratch
+inline std::vector<Large_Numbers>
+Large_Numbers::fibonacci_batch(std::span<const std::uint64_t> indices,
+                               const Parallel &parallel) {
+  auto order = std::vector<std::size_t>(indices.size());
+  for (std::size_t i = 0; i < order.size(); i++) {
+    order[i] = i;
+  }
+  std::sort(order.begin(), order.end(),
+            [&](auto lhs, auto rhs) { return indices[lhs] < indices[rhs]; });
+  // F(n) has about n * log10(phi) / 9 ~ n / 43 limbs
+  auto width = std::size_t(0);
+  for (auto n : indices) {
+    width += n / 43 + 1;
+  }
+  auto results = std::vector<Large_Numbers>(indices.size(), Zero());
+  op_for_chunks(
+      order.size(), op_chunk_count(order.size(), width, parallel), parallel,
+      [&](std::size_t, std::size_t begin, std::size_t end) {
+        auto f_n = Zero();
+        auto f_n_plus_1 = Zero();
+        auto n = indices[order[begin]];
+        std::tie(f_n, f_n_plus_1) = fibonacci_pair(n);
+        for (auto i = begin; i < end; i++) {
+          auto target = indices[order[i]];
+          if (target - n > Fibonacci_Type_Policy::incremental_steps) {
+            std::tie(f_n, f_n_plus_1) = fibonacci_pair(target);
+            n = target;
+          }
+          for (; n < target; n++) {
+            f_n += f_n_plus_1;
+            std::swap(f_n, f_n_plus_1);
+          }
+          results[order[i]] = f_n;
+        }
+      });
+  return results;
+}
+
+// Bounded, thread-safe cache of sequence states at sparse checkpoint indices.
+// A request for n resumes from the nearest checkpoint at or below n (via
+// Policy::Advance()), or starts from scratch (Policy::At()) when there is none
+// close enough to be worth it, and the state at n becomes a new checkpoint if
+// it is at least checkpoint_spacing past the one it came from.  When the
+// checkpoints go over memory_budget bytes, the least recently used ones are
+// evicted.  i.e.
+//
+//    auto cache = Sequence_Cache<Fibonacci_Policy>(16 << 20);
+//    auto f_n = cache.Get(100000);
+//    auto f_n_plus_10 = cache.Get(100010); // 10 additions from checkpoint
+//
+// The lock is only held for looking up/copying and inserting checkpoints,
+// the big number arithmetic runs outside of it.  Checkpoints always live in
+// std::pmr::get_default_resource(), whatever Memory_Resource_Scope (or
+// Arena) the caller is in, since they outlive the call
+template <typename Policy> class Sequence_Cache {
+public:
+  typedef typename Policy::State State;
+  struct Statistics {
+    std::uint64_t hits;      // n itself was a checkpoint
+    std::uint64_t resumes;   // advanced from a checkpoint below n
+    std::uint64_t misses;    // computed from scratch
+    std::uint64_t evictions; // checkpoints dropped to stay within the budget
+    std::size_t checkpoints;
+    std::size_t bytes;
+  };
+
+  explicit Sequence_Cache(std::size_t memory_budget = 64 << 20,
+                          std::uint64_t checkpoint_spacing = 64)
+      : memory_budget(memory_budget), checkpoint_spacing(checkpoint_spacing) {}
+  Sequence_Cache(const Sequence_Cache &) = delete;
+  Sequence_Cache &operator=(const Sequence_Cache &) = delete;
+
+  // first element of the state at n, i.e. F(n)
+  Large_Numbers Get(std::uint64_t n) { return std::get<0>(Get_State(n)); }
+
+  State Get_State(std::uint64_t n) {
+    std::optional<std::uint64_t> from_index;
+    std::optional<State> from_state;
+    {
+      auto lock = std::lock_guard<std::mutex>(mutex);
+      auto checkpoint = checkpoints.upper_bound(n);
+      if (checkpoint != checkpoints.begin()) {
+        checkpoint--;
+        from_index = checkpoint->first;
+        auto scope = Large_Numbers::Memory_Resource_Scope(
+            std::pmr::get_default_resource());
+        from_state = checkpoint->second.state;
+        lru.splice(lru.end(), lru, checkpoint->second.lru_position);
+      }
+    }
+    if (from_index && *from_index == n) {
+      hits++;
+      return std::move(*from_state);
+    }
+    // jumping further than n / 2 costs more than recomputing from scratch
+    auto resume = from_index && n - *from_index <= n / 2;
+    (resume ? resumes : misses)++;
+    auto result = resume ? Policy::Advance(*from_state, n - *from_index)
+                         : Policy::At(n);
+    if (!from_index || n - *from_index >= checkpoint_spacing) {
+      insert(n, result);
+    }
+    return result;
+  }
+
+  Statistics Stats() const {
+    auto lock = std::lock_guard<std::mutex>(mutex);
+    return {hits.load(), resumes.load(), misses.load(), evictions.load(),
+            checkpoints.size(), bytes};
+  }
+  void Clear() {
+    auto lock = std::lock_guard<std::mutex>(mutex);
+    checkpoints.clear();
+    lru.clear();
+    bytes = 0;
+  }
+
+private:
+  struct Checkpoint {
+    State state;
+    std::size_t bytes;
+    std::list<std::uint64_t>::iterator lru_position;
+  };
+
+  void insert(std::uint64_t n, const State &state) {
+    auto state_bytes = Policy::Bytes(state);
+    if (state_bytes > memory_budget) {
+      return;
+    }
+    auto lock = std::lock_guard<std::mutex>(mutex);
+    if (checkpoints.count(n) != 0) {
+      return; // another thread got here first
+    }
+    while (bytes + state_bytes > memory_budget) {
+      auto oldest = checkpoints.find(lru.front());
+      bytes -= oldest->second.bytes;
+      checkpoints.erase(oldest);
+      lru.pop_front();
+      evictions++;
+    }
+    lru.push_back(n);
+    auto scope = Large_Numbers::Memory_Resource_Scope(
+        std::pmr::get_default_resource());
+    checkpoints.emplace(n, Checkpoint{state, state_bytes, std::prev(lru.end())});
+    bytes += state_bytes;
+  }
+
+  const std::size_t memory_budget;
+  const std::uint64_t checkpoint_spacing;
+  mutable std::mutex mutex;
+  std::map<std::uint64_t, Checkpoint> checkpoints;
+  std::list<std::uint64_t> lru; // least recently used first
+  std::size_t bytes = 0;
+  std::atomic<std::uint64_t> hits{0};
+  std::atomic<std::uint64_t> resumes{0};
+  std::atomic<std::uint64_t> misses{0};
+  std::atomic<std::uint64_t> evictions{0};
+};
+
+// Order-k linear recurrence with big-integer coefficients
+//    a(n) = c[0] * a(n-1) + c[1] * a(n-2) + ... + c[k-1] * a(n-k)
+// given a(0), ..., a(k-1).  a(n) is evaluated by Kitamasa's method: with
+//    P(x) = x^k - c[0] * x^(k-1) - ... - c[k-1]
+// and r(x) = x^n mod P(x) = r[0] + r[1] * x + ... + r[k-1] * x^(k-1), then
+//    a(n) = r[0] * a(0) + ... + r[k-1] * a(k-1)
+// x^n mod P(x) takes log2(n) squarings mod P(x), O(k^2) multiplications of
+// Large_Numbers each, instead of O(k^3) for powers of the companion matrix.
+// i.e.
+//
+//    auto pell = Linear_Recurrence<2>::Pell();
+//    auto p_1000 = pell.At(1000);
+//
+// NOTE: Large_Numbers::Fibonacci() stays on its own fast doubling, which
+// needs 3 multiplications per bit rather than the 4 (+ reduction) here
+template <std::size_t Order> class Linear_Recurrence {
+  static_assert(Order >= 1, "a recurrence needs at least one term");
+
+public:
+  typedef std::vector<Large_Numbers> Polynomial; // Order coefficients, x^0 first
+
+  Linear_Recurrence(std::vector<Large_Numbers> coefficients,
+                    std::vector<Large_Numbers> initial)
+      : coefficients(std::move(coefficients)), initial(std::move(initial)) {
+    if (this->coefficients.size() != Order || this->initial.size() != Order) {
+      throw std::invalid_argument("Expected one coefficient and one initial "
+                                  "term per order of the recurrence");
+    }
+  }
+
+  // F(n) = F(n-1) + F(n-2), 0, 1
+  static Linear_Recurrence Fibonacci()
+    requires(Order == 2)
+  {
+    return Linear_Recurrence({number(1), number(1)}, {number(0), number(1)});
+  }
+  // L(n) = L(n-1) + L(n-2), 2, 1
+  static Linear_Recurrence Lucas()
+    requires(Order == 2)
+  {
+    return Linear_Recurrence({number(1), number(1)}, {number(2), number(1)});
+  }
+  // P(n) = 2 * P(n-1) + P(n-2), 0, 1
+  static Linear_Recurrence Pell()
+    requires(Order == 2)
+  {
+    return Linear_Recurrence({number(2), number(1)}, {number(0), number(1)});
+  }
+  // T(n) = T(n-1) + T(n-2) + T(n-3), 0, 0, 1
+  static Linear_Recurrence Tribonacci()
+    requires(Order == 3)
+  {
+    return Linear_Recurrence({number(1), number(1), number(1)},
+                             {number(0), number(0), number(1)});
+  }
+
+  Large_Numbers At(std::uint64_t n) const {
+    if (n < Order) {
+      return initial[n];
+    }
+    // left to right: square, then multiply by x where n has a bit set
+    auto remainder = one();
+    for (auto bit = std::bit_width(n); bit-- > 0;) {
+      remainder = multiply_mod(remainder, remainder);
+      if ((n >> bit) & 1) {
+        multiply_by_x(remainder);
+      }
+    }
+    return evaluate(remainder);
+  }
+
+  // batched evaluation: x^(2^j) mod P(x) is computed once for the largest
+  // index and shared, each index then only costs one multiplication mod
+  // P(x) per set bit
+  std::vector<Large_Numbers> At(const std::vector<std::uint64_t> &indices) const {
+    auto largest = std::uint64_t(0);
+    for (auto n : indices) {
+      largest = std::max(largest, n);
+    }
+    auto powers_of_two = std::vector<Polynomial>(); // x^(2^j) mod P(x)
+    auto x = one();
+    multiply_by_x(x);
+    for (std::size_t bit = 0; bit < std::bit_width(largest); bit++) {
+      powers_of_two.push_back(x);
+      if (bit + 1 < std::bit_width(largest)) {
+        x = multiply_mod(x, x);
+      }
+    }
+    auto results = std::vector<Large_Numbers>();
+    results.reserve(indices.size());
+    for (auto n : indices) {
+      if (n < Order) {
+        results.push_back(initial[n]);
+        continue;
+      }
+      auto remainder = std::optional<Polynomial>();
+      for (std::size_t bit = 0; bit < std::bit_width(n); bit++) {
+        if ((n >> bit) & 1) {
+          remainder = remainder ? multiply_mod(*remainder, powers_of_two[bit])
+                                : powers_of_two[bit];
+        }
+      }
+      results.push_back(evaluate(*remainder));
+    }
+    return results;
+  }
+
+private:
+  static Large_Numbers number(std::int64_t v) { return Large_Numbers(v); }
+  static Polynomial one() {
+    auto polynomial = Polynomial(Order, Large_Numbers::Zero());
+    polynomial[0] = number(1);
+    return polynomial;
+  }
+
+  // lhs * rhs mod P(x), folding x^d (d >= Order) back from the top with
+  // x^Order = c[0] * x^(Order-1) + ... + c[Order-1]
+  Polynomial multiply_mod(const Polynomial &lhs, const Polynomial &rhs) const {
+    auto product = Polynomial(2 * Order - 1, Large_Numbers::Zero());
+    for (std::size_t i = 0; i < Order; i++) {
+      if (lhs[i].Is_Zero()) {
+        continue;
+      }
+      for (std::size_t j = 0; j < Order; j++) {
+        if (!rhs[j].Is_Zero()) {
+          product[i + j] += lhs[i] * rhs[j];
+        }
+      }
+    }
+    for (auto degree = 2 * Order - 2; degree >= Order; degree--) {
+      if (!product[degree].Is_Zero()) {
+        for (std::size_t i = 0; i < Order; i++) {
+          product[degree - 1 - i] += product[degree] * coefficients[i];
+        }
+      }
+    }
+    product.resize(Order, Large_Numbers::Zero());
+    return product;
+  }
+  // polynomial * x mod P(x), which is a shift plus Order multiplications
+  void multiply_by_x(Polynomial &polynomial) const {
+    auto top = std::move(polynomial[Order - 1]);
+    for (auto degree = Order - 1; degree > 0; degree--) {
+      polynomial[degree] = std::move(polynomial[degree - 1]);
+    }
+    polynomial[0] = Large_Numbers::Zero();
+    if (top.Is_Zero()) {
+      return;
+    }
+    for (std::size_t i = 0; i < Order; i++) {
+      polynomial[Order - 1 - i] += top * coefficients[i];
+    }
+  }
+  Large_Numbers evaluate(const Polynomial &remainder) const {
+    auto result = Large_Numbers::Zero();
+    for (std::size_t i = 0; i < Order; i++) {
+      if (!remainder[i].Is_Zero() && !initial[i].Is_Zero()) {
+        result += remainder[i] * initial[i];
+      }
+    }
+    return result;
+  }
+
+  Polynomial coefficients; // c[0] multiplies a(n-1)
+  Polynomial initial;      // a(0), ..., a(Order-1)
+};
+
+inline void Large_Numbers::unit_test_fibonacci() {
+  std::clog << "Testing fibonacci (fast doubling, sequence):" << std::endl;
+  auto fibonacci_reference = Large_Numbers::Zero();
+  auto fibonacci_sequence = Fibonacci_Sequence();
+  for (std::uint64_t n = 0; n <= 300; n++) {
+    fibonacci_reference.value = fibonacci_reference.fibonacci_large_iter(n);
+    assert(Fibonacci(n) == fibonacci_reference);
+    assert(fibonacci_sequence.Index() == n);
+    assert(fibonacci_sequence.Current() == fibonacci_reference);
+    fibonacci_sequence.Next();
+  }
+  fibonacci_reference.value = fibonacci_reference.fibonacci_large_iter(4782);
+  assert(Fibonacci(4782) == fibonacci_reference);
+  assert(Fibonacci(4782).Size() == 1000 && Fibonacci(4781).Size() == 999);
+  auto fibonacci_from_4780 = Fibonacci_Sequence(4780);
+  fibonacci_from_4780.Next();
+  assert(fibonacci_from_4780.Next() == fibonacci_reference);
+  auto [index_1000_digits, fibonacci_1000_digits] =
+      first_fibonacci_with_digits(1000);
+  assert(index_1000_digits == 4782);
+  assert(fibonacci_1000_digits == fibonacci_reference);
+  auto digits_sequence = Fibonacci_Sequence(1);
+  for (std::uint64_t digits = 1; digits <= 500; digits++) {
+    while (digits_sequence.Current().Size() < digits) {
+      digits_sequence.Next();
+    }
+    auto [index, fibonacci] = first_fibonacci_with_digits(digits);
+    assert(index == digits_sequence.Index());
+    assert(fibonacci == digits_sequence.Current());
+  }
+  // wide enough for the doubling steps to go through Karatsuba/Toom-3
+  auto fibonacci_from_99999 = Fibonacci_Sequence(99999);
+  assert(Fibonacci(100000) == fibonacci_from_99999.Next());
+  assert(Fibonacci(100001) == fibonacci_from_99999.Next());
+  auto fibonacci_pool = Thread_Pool(3);
+  assert(Fibonacci(100001, Parallel{&fibonacci_pool, 16}) ==
+         Fibonacci(100001));
+  // the pool shared with unrelated tasks doing *=: the ones a waiting
+  // Fibonacci() steals must neither fork nor reuse its multiply buffers
+  auto fibonacci_shared = Fibonacci(120001);
+  auto shared_factor = Fibonacci(30000);
+  auto shared_product = fibonacci_shared * shared_factor;
+  auto fibonacci_threads = std::vector<std::thread>();
+  for (std::size_t i = 0; i < 3; i++) {
+    fibonacci_threads.emplace_back([&]() {
+      assert(Fibonacci(120001, Parallel{&fibonacci_pool, 64}) ==
+             fibonacci_shared);
+    });
+  }
+  auto user_group = Task_Group(fibonacci_pool);
+  for (std::size_t i = 0; i < 16; i++) {
+    user_group.Run([&]() {
+      auto x = fibonacci_shared;
+      x *= shared_factor;
+      assert(x == shared_product);
+    });
+  }
+  user_group.Wait();
+  for (auto &thread : fibonacci_threads) {
+    thread.join();
+  }
+  auto batch_indices =
+      std::vector<std::uint64_t>{5000, 7, 0, 5001, 5064, 5000, 90000, 1, 5200};
+  for (auto batch_parallel :
+       {Parallel{&fibonacci_pool, 1}, Parallel{&fibonacci_pool, 1 << 30}}) {
+    auto batch = fibonacci_batch(batch_indices, batch_parallel);
+    for (std::size_t i = 0; i < batch_indices.size(); i++) {
+      assert(batch[i] == Fibonacci(batch_indices[i]));
+    }
+  }
+  assert(fibonacci_batch(std::vector<std::uint64_t>()).empty());
+
+  std::clog << "Testing sequence cache:" << std::endl;
+  auto fibonacci_cache = Sequence_Cache<Fibonacci_Policy>();
+  assert(fibonacci_cache.Get(10000) == Fibonacci(10000)); // miss
+  assert(fibonacci_cache.Get(10000) == Fibonacci(10000)); // hit
+  assert(fibonacci_cache.Get(10010) == Fibonacci(10010)); // additions
+  assert(fibonacci_cache.Get(19000) == Fibonacci(19000)); // doubling jump
+  auto statistics = fibonacci_cache.Stats();
+  assert(statistics.hits == 1 && statistics.resumes == 2);
+  assert(statistics.misses == 1 && statistics.checkpoints == 2);
+  {
+    // checkpoints made inside an Arena must not point into it
+    auto arena_cache = Sequence_Cache<Fibonacci_Policy>();
+    {
+      Arena arena;
+      assert(arena_cache.Get(10000) == Fibonacci(10000));
+    }
+    assert(arena_cache.Get(10005) == Fibonacci(10005)); // resumes from 10000
+    assert(arena_cache.Stats().resumes == 1);
+  }
+  auto lucas_cache = Sequence_Cache<Lucas_Policy>();
+  auto lucas_n = Large_Numbers(std::int64_t(2));
+  auto lucas_n_plus_1 = Large_Numbers(std::int64_t(1));
+  for (std::uint64_t n = 0; n <= 1000; n++) {
+    if (n % 37 == 0 || n > 990) {
+      assert(lucas_cache.Get(n) == lucas_n);
+    }
+    lucas_n += lucas_n_plus_1;
+    std::swap(lucas_n, lucas_n_plus_1);
+  }
+  // tiny budget: must evict, and stay within it
+  auto small_cache = Sequence_Cache<Fibonacci_Policy>(4096, 8);
+  auto cache_threads = std::vector<std::thread>();
+  for (auto thread = 0; thread < 4; thread++) {
+    cache_threads.emplace_back([&small_cache, thread]() {
+      for (std::uint64_t n = 100 + thread; n < 3000; n += 97) {
+        assert(small_cache.Get(n) == Fibonacci(n));
+      }
+    });
+  }
+  for (auto &cache_thread : cache_threads) {
+    cache_thread.join();
+  }
+  statistics = small_cache.Stats();
+  std::clog << "hits: " << statistics.hits << ", resumes: " << statistics.resumes
+            << ", misses: " << statistics.misses
+            << ", evictions: " << statistics.evictions
+            << ", checkpoints: " << statistics.checkpoints
+            << ", bytes: " << statistics.bytes << std::endl;
+  assert(statistics.evictions > 0 && statistics.bytes <= 4096);
+
+  std::clog << "Testing linear recurrences:" << std::endl;
+  // term by term, straight from the definition
+  auto naive_terms = [](const std::vector<Large_Numbers> &coefficients,
+                        const std::vector<Large_Numbers> &initial,
+                        std::uint64_t count) {
+    auto terms = initial;
+    while (terms.size() < count) {
+      auto term = Large_Numbers::Zero();
+      for (std::size_t i = 0; i < coefficients.size(); i++) {
+        term += coefficients[i] * terms[terms.size() - 1 - i];
+      }
+      terms.push_back(term);
+    }
+    return terms;
+  };
+  auto fibonacci_recurrence = Linear_Recurrence<2>::Fibonacci();
+  auto lucas_recurrence = Linear_Recurrence<2>::Lucas();
+  for (std::uint64_t n : {0, 1, 2, 3, 10, 100, 1000, 4782, 12345}) {
+    assert(fibonacci_recurrence.At(n) == Fibonacci(n));
+    assert(lucas_recurrence.At(n) == std::get<0>(Lucas_Policy::At(n)));
+  }
+  auto pell_terms = naive_terms({Large_Numbers(std::int64_t(2)),
+                                 Large_Numbers(std::int64_t(1))},
+                                {Zero(), Large_Numbers(std::int64_t(1))}, 300);
+  auto tribonacci_terms = naive_terms(
+      {Large_Numbers(std::int64_t(1)), Large_Numbers(std::int64_t(1)),
+       Large_Numbers(std::int64_t(1))},
+      {Zero(), Zero(), Large_Numbers(std::int64_t(1))}, 300);
+  // order 4, big and negative coefficients
+  auto odd_coefficients = std::vector<Large_Numbers>{
+      Large_Numbers("123456789012345678901234567890"), Zero(),
+      Large_Numbers(std::int64_t(-7)), Large_Numbers("-98765432109876543210")};
+  auto odd_initial = std::vector<Large_Numbers>{
+      Large_Numbers(std::int64_t(3)), Large_Numbers(std::int64_t(-1)), Zero(),
+      Large_Numbers("5000000000000000000000")};
+  auto odd_terms = naive_terms(odd_coefficients, odd_initial, 100);
+  auto pell_recurrence = Linear_Recurrence<2>::Pell();
+  auto tribonacci_recurrence = Linear_Recurrence<3>::Tribonacci();
+  auto odd_recurrence = Linear_Recurrence<4>(odd_coefficients, odd_initial);
+  auto indices = std::vector<std::uint64_t>();
+  for (std::uint64_t n = 0; n < 300; n++) {
+    assert(pell_recurrence.At(n) == pell_terms[n]);
+    assert(tribonacci_recurrence.At(n) == tribonacci_terms[n]);
+    if (n < 100) {
+      assert(odd_recurrence.At(n) == odd_terms[n]);
+    }
+    indices.push_back((n * 7919) % 300);
+  }
+  auto pell_batch = pell_recurrence.At(indices);
+  auto tribonacci_batch = tribonacci_recurrence.At(indices);
+  for (std::size_t i = 0; i < indices.size(); i++) {
+    assert(pell_batch[i] == pell_terms[indices[i]]);
+    assert(tribonacci_batch[i] == tribonacci_terms[indices[i]]);
+  }
+}
+
+inline void Large_Numbers::unit_test_serialization() {
+  std::clog << "Testing binary serialization:" << std::endl;
+  auto samples = std::vector<Large_Numbers>{
+      Zero(), Large_Numbers(std::int64_t(-7)),
+      Large_Numbers("-123456789012345678901234567890"), Fibonacci(10000)};
+  for (const auto &sample : samples) {
+    auto stream = std::stringstream();
+    sample.serialize(stream);
+    assert(stream.str().size() == sample.serialized_size());
+    assert(deserialize(stream) == sample);
+  }
+  auto serialized_stream = std::stringstream();
+  samples[2].serialize(serialized_stream);
+  auto serialized = serialized_stream.str();
+  auto rejects = [](const std::string &bytes) {
+    auto stream = std::stringstream(bytes);
+    try {
+      deserialize(stream);
+    } catch (const std::invalid_argument &) {
+      return true;
+    }
+    return false;
+  };
+  assert(rejects("LNUM"));
+  assert(rejects("XNUM" + serialized.substr(4)));
+  assert(rejects(serialized.substr(0, serialized.size() - 1)));
+  // forged limb counts with no limbs behind them: rejected as truncated, not
+  // by std::bad_alloc (nor after allocating them all)
+  for (std::uint64_t forged_count : {std::uint64_t(1) << 28,
+                                     std::uint64_t(1) << 60}) {
+    unsigned char forged[SERIAL_HEADER_SIZE];
+    encode_serial_header(forged, true, forged_count);
+    assert(rejects(std::string(reinterpret_cast<const char *>(forged),
+                               SERIAL_HEADER_SIZE) +
+                   serialized.substr(SERIAL_HEADER_SIZE)));
+  }
+  auto out_of_range = serialized;
+  out_of_range[SERIAL_HEADER_SIZE + 3] = '\xff'; // lowest limb >= 10^9
+  assert(rejects(out_of_range));
+  auto negative_zero = std::string(SERIAL_HEADER_SIZE + sizeof(limb_t), '\0');
+  encode_serial_header(
+      reinterpret_cast<unsigned char *>(negative_zero.data()), false, 1);
+  auto negative_zero_stream = std::stringstream(negative_zero);
+  auto zero = deserialize(negative_zero_stream);
+  assert(zero.Is_Zero() && zero.is_positive);
+  auto zero_stream = std::stringstream();
+  zero.serialize(zero_stream);
+  auto expected_zero_stream = std::stringstream();
+  samples[0].serialize(expected_zero_stream);
+  assert(zero_stream.str() == expected_zero_stream.str());
+  assert(isqrt(zero).Is_Zero() && is_perfect_square(zero));
+
+  // view over an (aligned) in-memory copy of the bytes
+  auto aligned = std::vector<limb_t>(serialized.size() / sizeof(limb_t));
+  std::memcpy(aligned.data(), serialized.data(), serialized.size());
+  auto view = View::From_Bytes(aligned.data(), serialized.size());
+  assert(!view.Is_Positive() && view.Size() == 30);
+  assert(view.Get() == samples[2].Get());
+  assert(Large_Numbers(view) == samples[2]);
+  auto operand = Fibonacci(300);
+  assert(operand + view == operand + samples[2]);
+  assert(operand - view == operand - samples[2]);
+  assert(operand * view == operand * samples[2]);
+  operand *= view;
+  assert(operand == Fibonacci(300) * samples[2]);
+  auto view_rejected = false;
+  try {
+    View::From_Bytes(aligned.data(), serialized.size() - 1);
+  } catch (const std::invalid_argument &) {
+    view_rejected = true;
+  }
+  assert(view_rejected);
+
+#ifdef LARGE_NUMBERS_HAS_MMAP
+  auto path = (std::filesystem::temp_directory_path() /
+               "large_numbers_unit_test.lnum")
+                  .string();
+  {
+    auto file = std::ofstream(path, std::ios::binary);
+    samples[3].serialize(file);
+  }
+  {
+    auto mapped = Mapped_File(path);
+    auto mapped_view = View::From_Bytes(mapped.Data(), mapped.Size());
+    assert(Large_Numbers(mapped_view) == samples[3]);
+    assert(Fibonacci(9999) + mapped_view == Fibonacci(10001));
+  }
+  std::filesystem::remove(path);
+#endif // LARGE_NUMBERS_HAS_MMAP
+}
 } // namespace libs
 } // namespace hairev
 